@@ -653,7 +653,7 @@ ifneq ($(strip $(DEBOUNCE_TYPE)), custom)
 endif
 
 
-VALID_SERIAL_DRIVER_TYPES := bitbang usart vendor
+VALID_SERIAL_DRIVER_TYPES := bitbang bitbang_dma usart vendor
 
 SERIAL_DRIVER ?= bitbang
 ifeq ($(filter $(SERIAL_DRIVER),$(VALID_SERIAL_DRIVER_TYPES)),)
@@ -675,8 +675,21 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
 
         OPT_DEFS += -DSPLIT_COMMON_TRANSACTIONS
 
+        ifeq ($(strip $(SPLIT_TRANSACTION_DELTA)), yes)
+            OPT_DEFS += -DSPLIT_TRANSACTION_DELTA
+            QUANTUM_SRC += $(QUANTUM_DIR)/split_common/split_delta.c
+        endif
+
+        ifeq ($(strip $(SPLIT_LINK_STATS_ENABLE)), yes)
+            OPT_DEFS += -DSPLIT_LINK_STATS_ENABLE
+            QUANTUM_SRC += $(QUANTUM_DIR)/split_common/split_link_stats.c
+        endif
+
         # Functions added via QUANTUM_LIB_SRC are only included in the final binary if they're called.
         # Unused functions are pruned away, which is why we can add multiple drivers here without bloat.
+        # SPLIT_TRANSACTION_BUDGET is set in config.h, so the schedule is always added this way.
+        QUANTUM_LIB_SRC += split_budget.c
+
         ifeq ($(PLATFORM),AVR)
             ifneq ($(NO_I2C),yes)
                 QUANTUM_LIB_SRC += i2c_master.c \
@@ -960,6 +973,11 @@ endif
 ifeq ($(strip $(I2C_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_I2C=TRUE
     QUANTUM_LIB_SRC += i2c_master.c
+
+    ifeq ($(strip $(I2C_ASYNC_ENABLE)), yes)
+        OPT_DEFS += -DI2C_ASYNC_ENABLE
+        QUANTUM_LIB_SRC += i2c_async.c
+    endif
 endif
 
 ifeq ($(strip $(SPI_DRIVER_REQUIRED)), yes)
@@ -42,6 +42,7 @@ GENERIC_FEATURES = \
     MOUSEKEY \
     MUSIC \
     OS_DETECTION \
+    PROFILER \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
     SECURE \
@@ -50,6 +51,7 @@ GENERIC_FEATURES = \
     SPACE_CADET \
     SWAP_HANDS \
     TAP_DANCE \
+    TASK_SCHEDULER \
     TRI_LAYER \
     VIA \
     VIRTSER \
@@ -0,0 +1,266 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_async.h"
+#include "spsc_queue.h"
+#include <string.h>
+
+SPSC_QUEUE_STATIC_ASSERT(I2C_ASYNC_QUEUE_SIZE > 0 && I2C_ASYNC_QUEUE_SIZE <= 128 && (I2C_ASYNC_QUEUE_SIZE & (I2C_ASYNC_QUEUE_SIZE - 1)) == 0, "I2C_ASYNC_QUEUE_SIZE must be a power of two, no larger than 128");
+
+typedef enum {
+    I2C_ASYNC_TRANSMIT,
+    I2C_ASYNC_RECEIVE,
+    I2C_ASYNC_READ_REGISTER,
+    I2C_ASYNC_READ_REGISTER16,
+} i2c_async_type_t;
+
+typedef struct {
+    uint8_t              type;
+    uint8_t              address;
+    uint16_t             timeout;
+    uint16_t             tx_offset; // Start of the bytes to transmit in the transmit buffer
+    uint16_t             tx_length;
+    uint16_t             tx_used; // Transmit buffer space to release on completion, including any skipped wrap around
+    uint8_t             *rx_data;
+    uint16_t             rx_length;
+    i2c_status_t         status;
+    i2c_async_callback_t callback;
+    void                *context;
+} i2c_async_transfer_t;
+
+// Transfers between tail and exec have completed and wait for their callback, those between exec and head are yet to
+// be executed. head and tail are only written by the main loop, exec only by the worker.
+static struct {
+    volatile uint8_t     head;
+    volatile uint8_t     exec;
+    volatile uint8_t     tail;
+    i2c_async_transfer_t transfers[I2C_ASYNC_QUEUE_SIZE];
+} i2c_async_queue;
+
+// The bytes to transmit are allocated in queue order and released in completion order, so the buffer is used as a
+// ring. Only the main loop allocates and releases.
+static uint8_t  i2c_async_buffer[I2C_ASYNC_BUFFER_SIZE];
+static uint16_t i2c_async_buffer_head = 0;
+static uint16_t i2c_async_buffer_used = 0;
+
+static bool i2c_async_initialized = false;
+static bool i2c_async_has_worker  = false;
+
+__attribute__((weak)) bool i2c_async_worker_start(void) {
+    return false;
+}
+
+__attribute__((weak)) void i2c_async_worker_notify(void) {}
+
+__attribute__((weak)) void i2c_async_worker_wait(void) {}
+
+/**
+ * @brief Reserves the next queue slot and the transmit buffer space for a transfer, without publishing it yet.
+ */
+static i2c_async_transfer_t *i2c_async_reserve(i2c_async_type_t type, uint8_t address, uint16_t tx_length, uint16_t timeout, i2c_async_callback_t callback, void *context) {
+    if (!i2c_async_initialized) {
+        i2c_async_initialized = true;
+        i2c_async_has_worker  = i2c_async_worker_start();
+    }
+
+    uint8_t head = i2c_async_queue.head;
+    if ((uint8_t)(head - i2c_async_queue.tail) >= I2C_ASYNC_QUEUE_SIZE) {
+        return NULL;
+    }
+
+    // Transfers always take up consecutive bytes, so space left at the end of the buffer may have to be skipped
+    uint16_t offset = i2c_async_buffer_head;
+    uint16_t used   = tx_length;
+    if (tx_length > I2C_ASYNC_BUFFER_SIZE - offset) {
+        used += I2C_ASYNC_BUFFER_SIZE - offset;
+        offset = 0;
+    }
+    if (tx_length > I2C_ASYNC_BUFFER_SIZE || used > I2C_ASYNC_BUFFER_SIZE - i2c_async_buffer_used) {
+        return NULL;
+    }
+    i2c_async_buffer_head = offset + tx_length;
+    i2c_async_buffer_used += used;
+
+    i2c_async_transfer_t *transfer = &i2c_async_queue.transfers[head & (I2C_ASYNC_QUEUE_SIZE - 1)];
+    transfer->type                 = type;
+    transfer->address              = address;
+    transfer->timeout              = timeout;
+    transfer->tx_offset            = offset;
+    transfer->tx_length            = tx_length;
+    transfer->tx_used              = used;
+    transfer->rx_data              = NULL;
+    transfer->rx_length            = 0;
+    transfer->callback             = callback;
+    transfer->context              = context;
+    return transfer;
+}
+
+/**
+ * @brief Publishes the transfer reserved last to the worker.
+ */
+static void i2c_async_commit(void) {
+    // The transfer has to be complete before the worker may see it
+    SPSC_QUEUE_BARRIER();
+    i2c_async_queue.head = i2c_async_queue.head + 1;
+
+    if (i2c_async_has_worker) {
+        i2c_async_worker_notify();
+    }
+}
+
+/**
+ * @brief Releases the completed transfers and invokes their callbacks.
+ */
+static void i2c_async_dispatch(void) {
+    uint8_t tail;
+    while ((tail = i2c_async_queue.tail) != i2c_async_queue.exec) {
+        SPSC_QUEUE_BARRIER();
+        i2c_async_transfer_t *transfer = &i2c_async_queue.transfers[tail & (I2C_ASYNC_QUEUE_SIZE - 1)];
+        i2c_async_callback_t  callback = transfer->callback;
+        void                 *context  = transfer->context;
+        i2c_status_t          status   = transfer->status;
+
+        i2c_async_buffer_used -= transfer->tx_used;
+        if (i2c_async_buffer_used == 0) {
+            i2c_async_buffer_head = 0;
+        }
+        // Released before the callback is invoked, so that it can queue a follow up transfer
+        i2c_async_queue.tail = tail + 1;
+
+        if (callback) {
+            callback(status, context);
+        }
+    }
+}
+
+bool i2c_async_execute(void) {
+    uint8_t exec = i2c_async_queue.exec;
+    if (exec == i2c_async_queue.head) {
+        return false;
+    }
+    SPSC_QUEUE_BARRIER();
+
+    i2c_async_transfer_t *transfer = &i2c_async_queue.transfers[exec & (I2C_ASYNC_QUEUE_SIZE - 1)];
+    const uint8_t        *tx       = &i2c_async_buffer[transfer->tx_offset];
+    switch (transfer->type) {
+        case I2C_ASYNC_TRANSMIT:
+            transfer->status = i2c_transmit(transfer->address, tx, transfer->tx_length, transfer->timeout);
+            break;
+        case I2C_ASYNC_RECEIVE:
+            transfer->status = i2c_receive(transfer->address, transfer->rx_data, transfer->rx_length, transfer->timeout);
+            break;
+        case I2C_ASYNC_READ_REGISTER:
+            transfer->status = i2c_read_register(transfer->address, tx[0], transfer->rx_data, transfer->rx_length, transfer->timeout);
+            break;
+        case I2C_ASYNC_READ_REGISTER16:
+            transfer->status = i2c_read_register16(transfer->address, (tx[0] << 8) | tx[1], transfer->rx_data, transfer->rx_length, transfer->timeout);
+            break;
+    }
+
+    // The status has to be complete before the main loop may see it
+    SPSC_QUEUE_BARRIER();
+    i2c_async_queue.exec = exec + 1;
+    return true;
+}
+
+bool i2c_async_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context) {
+    i2c_async_transfer_t *transfer = i2c_async_reserve(I2C_ASYNC_TRANSMIT, address, length, timeout, callback, context);
+    if (!transfer) {
+        return false;
+    }
+    memcpy(&i2c_async_buffer[transfer->tx_offset], data, length);
+    i2c_async_commit();
+    return true;
+}
+
+bool i2c_async_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context) {
+    i2c_async_transfer_t *transfer = i2c_async_reserve(I2C_ASYNC_RECEIVE, address, 0, timeout, callback, context);
+    if (!transfer) {
+        return false;
+    }
+    transfer->rx_data   = data;
+    transfer->rx_length = length;
+    i2c_async_commit();
+    return true;
+}
+
+bool i2c_async_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context) {
+    i2c_async_transfer_t *transfer = i2c_async_reserve(I2C_ASYNC_TRANSMIT, devaddr, length + 1, timeout, callback, context);
+    if (!transfer) {
+        return false;
+    }
+    i2c_async_buffer[transfer->tx_offset] = regaddr;
+    memcpy(&i2c_async_buffer[transfer->tx_offset + 1], data, length);
+    i2c_async_commit();
+    return true;
+}
+
+bool i2c_async_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context) {
+    i2c_async_transfer_t *transfer = i2c_async_reserve(I2C_ASYNC_TRANSMIT, devaddr, length + 2, timeout, callback, context);
+    if (!transfer) {
+        return false;
+    }
+    i2c_async_buffer[transfer->tx_offset]     = regaddr >> 8;
+    i2c_async_buffer[transfer->tx_offset + 1] = regaddr & 0xFF;
+    memcpy(&i2c_async_buffer[transfer->tx_offset + 2], data, length);
+    i2c_async_commit();
+    return true;
+}
+
+bool i2c_async_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context) {
+    i2c_async_transfer_t *transfer = i2c_async_reserve(I2C_ASYNC_READ_REGISTER, devaddr, 1, timeout, callback, context);
+    if (!transfer) {
+        return false;
+    }
+    i2c_async_buffer[transfer->tx_offset] = regaddr;
+    transfer->rx_data                     = data;
+    transfer->rx_length                   = length;
+    i2c_async_commit();
+    return true;
+}
+
+bool i2c_async_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context) {
+    i2c_async_transfer_t *transfer = i2c_async_reserve(I2C_ASYNC_READ_REGISTER16, devaddr, 2, timeout, callback, context);
+    if (!transfer) {
+        return false;
+    }
+    i2c_async_buffer[transfer->tx_offset]     = regaddr >> 8;
+    i2c_async_buffer[transfer->tx_offset + 1] = regaddr & 0xFF;
+    transfer->rx_data                         = data;
+    transfer->rx_length                       = length;
+    i2c_async_commit();
+    return true;
+}
+
+bool i2c_async_idle(void) {
+    return i2c_async_queue.head == i2c_async_queue.tail;
+}
+
+bool i2c_async_wait(void) {
+    if (i2c_async_idle()) {
+        return false;
+    }
+
+    while (i2c_async_queue.exec == i2c_async_queue.tail) {
+        if (i2c_async_has_worker) {
+            i2c_async_worker_wait();
+        } else {
+            i2c_async_execute();
+        }
+    }
+    i2c_async_dispatch();
+    return true;
+}
+
+void i2c_async_flush(void) {
+    while (i2c_async_wait()) {
+    }
+}
+
+void i2c_async_task(void) {
+    if (!i2c_async_has_worker) {
+        while (i2c_async_execute()) {
+        }
+    }
+    i2c_async_dispatch();
+}
@@ -0,0 +1,91 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "i2c_master.h"
+
+/**
+ * Asynchronous I2C transfers.
+ *
+ * Transfers are queued and executed in order, on a worker thread where the platform provides one (ChibiOS), or from
+ * i2c_async_task() otherwise. The bytes to transmit are copied when a transfer is queued, so the caller's buffer may
+ * be reused right away. Buffers to receive into have to stay valid until the callback has been invoked.
+ *
+ * Callbacks are always invoked from the main loop, by i2c_async_task(), i2c_async_wait() or i2c_async_flush(), and
+ * may queue further transfers. Addresses follow the convention of i2c_master.h and are expected to be already shifted.
+ *
+ * The queue functions return false without queueing anything if the queue or the transmit buffer is full.
+ */
+
+#ifndef I2C_ASYNC_QUEUE_SIZE
+#    define I2C_ASYNC_QUEUE_SIZE 32
+#endif
+
+#ifndef I2C_ASYNC_BUFFER_SIZE
+#    define I2C_ASYNC_BUFFER_SIZE 512
+#endif
+
+typedef void (*i2c_async_callback_t)(i2c_status_t status, void *context);
+
+bool i2c_async_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context);
+bool i2c_async_receive(uint8_t address, uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context);
+bool i2c_async_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context);
+bool i2c_async_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context);
+bool i2c_async_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context);
+bool i2c_async_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t *data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void *context);
+
+/**
+ * @brief Returns true if no transfers are queued or waiting for their callback.
+ */
+bool i2c_async_idle(void);
+
+/**
+ * @brief Blocks until the oldest queued transfer has completed, and invokes the callbacks of all completed transfers.
+ *
+ * @return false if there was nothing to wait for
+ */
+bool i2c_async_wait(void);
+
+/**
+ * @brief Blocks until all queued transfers have completed and their callbacks have been invoked.
+ */
+void i2c_async_flush(void);
+
+/**
+ * @brief Invokes the callbacks of the completed transfers, and executes the queued transfers if there is no worker
+ * thread. Called from the main loop.
+ */
+void i2c_async_task(void);
+
+/**
+ * @brief Executes the oldest queued transfer that has not been executed yet.
+ *
+ * Only to be called by the worker thread, or by the main loop if there is none.
+ *
+ * @return false if there was no transfer to execute
+ */
+bool i2c_async_execute(void);
+
+// Platform hooks for running the transfers on a worker thread. The worker calls i2c_async_execute() until it returns
+// false whenever it has been notified.
+
+/**
+ * @brief Starts the worker thread, before the first transfer is queued.
+ *
+ * @return false if the platform has no worker thread
+ */
+bool i2c_async_worker_start(void);
+
+/**
+ * @brief Wakes up the worker thread after a transfer was queued.
+ */
+void i2c_async_worker_notify(void);
+
+/**
+ * @brief Lets the worker thread run while the main loop waits for a transfer to complete.
+ */
+void i2c_async_worker_wait(void);
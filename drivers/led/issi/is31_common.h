@@ -0,0 +1,55 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "i2c_master.h"
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#endif
+
+// The IS31 and SNLED27351 drivers transmit their PWM buffers in fixed size chunks. Instead of a single dirty flag,
+// each buffer keeps one bit per chunk, so that a flush only transmits the chunks that contain changed registers.
+// A buffer may be split into at most 16 chunks.
+typedef uint16_t is31_dirty_chunks_t;
+
+/**
+ * @def Dirty bit of the chunk containing the given buffer offset.
+ */
+#define IS31_DIRTY_CHUNK(reg, chunk_size) ((is31_dirty_chunks_t)1 << ((reg) / (chunk_size)))
+
+/**
+ * @brief Writes consecutive registers, starting at `reg`.
+ *
+ * With I2C_ASYNC_ENABLE the write is queued and this returns right away, waiting only while the queue is full.
+ * Retrying needs the outcome of the write, so with a `persistence` of more than one attempt the write is blocking,
+ * and attempted up to `persistence` times.
+ */
+static inline void is31_write_registers(uint8_t address, uint8_t reg, const uint8_t *data, uint8_t length, uint8_t persistence, uint16_t timeout) {
+#ifdef I2C_ASYNC_ENABLE
+    if (persistence <= 1) {
+        do {
+            if (i2c_async_write_register(address << 1, reg, data, length, timeout, NULL, NULL)) return;
+        } while (i2c_async_wait());
+    }
+#endif
+
+    uint8_t attempt = 0;
+    do {
+        if (i2c_write_register(address << 1, reg, data, length, timeout) == I2C_STATUS_SUCCESS) break;
+    } while (++attempt < persistence);
+}
+
+/**
+ * @brief Transmits the dirty chunks of a register buffer.
+ *
+ * Chunk n is written to the consecutive registers starting at `first_register + n * chunk_size`.
+ */
+static inline void is31_write_dirty_chunks(uint8_t address, uint8_t first_register, const uint8_t *buffer, uint8_t chunk_size, is31_dirty_chunks_t dirty, uint8_t persistence, uint16_t timeout) {
+    for (uint8_t i = 0; dirty; i += chunk_size, dirty >>= 1) {
+        if (dirty & 1) {
+            is31_write_registers(address, first_register + i, buffer + i, chunk_size, persistence, timeout);
+        }
+    }
+}
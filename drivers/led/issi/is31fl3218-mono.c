@@ -16,6 +16,7 @@
 
 #include "is31fl3218-mono.h"
 #include "i2c_master.h"
+#include "is31_common.h"
 #include "gpio.h"
 
 #define IS31FL3218_PWM_REGISTER_COUNT 18
@@ -45,23 +46,11 @@ is31fl3218_driver_t driver_buffers = {
 };
 
 void is31fl3218_write_register(uint8_t reg, uint8_t data) {
-#if IS31FL3218_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3218_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, reg, &data, 1, IS31FL3218_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, reg, &data, 1, IS31FL3218_I2C_TIMEOUT);
-#endif
+    is31_write_registers(IS31FL3218_I2C_ADDRESS, reg, &data, 1, IS31FL3218_I2C_PERSISTENCE, IS31FL3218_I2C_TIMEOUT);
 }
 
 void is31fl3218_write_pwm_buffer(void) {
-#if IS31FL3218_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3218_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, IS31FL3218_REG_PWM, driver_buffers.pwm_buffer, 18, IS31FL3218_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(IS31FL3218_I2C_ADDRESS << 1, IS31FL3218_REG_PWM, driver_buffers.pwm_buffer, 18, IS31FL3218_I2C_TIMEOUT);
-#endif
+    is31_write_registers(IS31FL3218_I2C_ADDRESS, IS31FL3218_REG_PWM, driver_buffers.pwm_buffer, 18, IS31FL3218_I2C_PERSISTENCE, IS31FL3218_I2C_TIMEOUT);
 }
 
 void is31fl3218_init(void) {
@@ -3,6 +3,7 @@
 
 #include "is31fl3236.h"
 #include "i2c_master.h"
+#include "is31_common.h"
 #include "gpio.h"
 
 #define IS31FL3236_PWM_REGISTER_COUNT 36
@@ -48,23 +49,11 @@ is31fl3236_driver_t driver_buffers[IS31FL3236_DRIVER_COUNT] = {{
 }};
 
 void is31fl3236_write_register(uint8_t index, uint8_t reg, uint8_t data) {
-#if IS31FL3236_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3236_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3236_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(i2c_addresses[index] << 1, reg, &data, 1, IS31FL3236_I2C_TIMEOUT);
-#endif
+    is31_write_registers(i2c_addresses[index], reg, &data, 1, IS31FL3236_I2C_PERSISTENCE, IS31FL3236_I2C_TIMEOUT);
 }
 
 void is31fl3236_write_pwm_buffer(uint8_t index) {
-#if IS31FL3236_I2C_PERSISTENCE > 0
-    for (uint8_t i = 0; i < IS31FL3236_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(i2c_addresses[index] << 1, IS31FL3236_REG_PWM, driver_buffers[index].pwm_buffer, 36, IS31FL3236_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
-    }
-#else
-    i2c_write_register(i2c_addresses[index] << 1, IS31FL3236_REG_PWM, driver_buffers[index].pwm_buffer, 36, IS31FL3236_I2C_TIMEOUT);
-#endif
+    is31_write_registers(i2c_addresses[index], IS31FL3236_REG_PWM, driver_buffers[index].pwm_buffer, 36, IS31FL3236_I2C_PERSISTENCE, IS31FL3236_I2C_TIMEOUT);
 }
 
 void is31fl3236_init_drivers(void) {
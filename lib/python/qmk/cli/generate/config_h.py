@@ -167,6 +167,19 @@ def generate_split_config(kb_info_json, config_h_lines):
         generate_encoder_config(kb_info_json['split']['encoder']['right'], config_h_lines, '_RIGHT')
 
 
+def generate_tapping_config(kb_info_json, config_h_lines):
+    """Generate the config.h lines for the per keycode tap-hold table."""
+    entries = []
+    for keycode, settings in kb_info_json['tapping']['keys'].items():
+        flags = [
+            ('TAP_HOLD_PERMISSIVE_HOLD' if settings['permissive_hold'] else '0') if 'permissive_hold' in settings else 'TAP_HOLD_DEFAULT_PERMISSIVE_HOLD',
+            ('TAP_HOLD_HOLD_ON_OTHER_KEY_PRESS' if settings['hold_on_other_key_press'] else '0') if 'hold_on_other_key_press' in settings else 'TAP_HOLD_DEFAULT_HOLD_ON_OTHER_KEY_PRESS',
+        ]
+        entries.append(f'{{{keycode}, {settings.get("term", "TAPPING_TERM")}, {settings.get("quick_tap_term", "QUICK_TAP_TERM")}, {" | ".join(flags)}}}')
+
+    config_h_lines.append(generate_define('TAP_HOLD_TABLE', f'{{ {", ".join(entries)} }}'))
+
+
 def generate_led_animations_config(feature, led_feature_json, config_h_lines, enable_prefix, animation_prefix):
     if 'animation' in led_feature_json.get('default', {}):
         config_h_lines.append(generate_define(f'{feature.upper()}_DEFAULT_MODE', f'{animation_prefix}{led_feature_json["default"]["animation"].upper()}'))
@@ -213,9 +226,15 @@ def generate_config_h(cli):
     if 'split' in kb_info_json:
         generate_split_config(kb_info_json, config_h_lines)
 
+    if 'keys' in kb_info_json.get('tapping', {}):
+        generate_tapping_config(kb_info_json, config_h_lines)
+
     if 'led_matrix' in kb_info_json:
         generate_led_animations_config('led_matrix', kb_info_json['led_matrix'], config_h_lines, 'ENABLE_LED_MATRIX_', 'LED_MATRIX_')
 
+    if 'layout' in kb_info_json.get('rgb_matrix', {}):
+        config_h_lines.append(generate_define('RGB_MATRIX_GEOMETRY_GENERATED'))
+
     if 'rgb_matrix' in kb_info_json:
         generate_led_animations_config('rgb_matrix', kb_info_json['rgb_matrix'], config_h_lines, 'ENABLE_RGB_MATRIX_', 'RGB_MATRIX_')
 
@@ -1,5 +1,7 @@
 """Used by the make system to generate keyboard.c from info.json.
 """
+from math import isqrt
+
 from milc import cli
 
 from qmk.info import info_json
@@ -21,6 +23,49 @@ def _gen_led_configs(info_data):
     return lines
 
 
+def _sqrt16(x):
+    """Matches sqrt16() from lib8tion, including the 16 bit truncation of its argument
+    """
+    return min(isqrt(x & 0xFFFF), 255)
+
+
+def _atan2_8(dy, dx):
+    """Matches atan2_8() from lib8tion, including its truncating integer division
+    """
+    def c_div(a, b):
+        return abs(a) // abs(b) * (1 if (a < 0) == (b < 0) else -1)
+
+    if dy == 0:
+        return 0 if dx >= 0 else 128
+
+    abs_y = abs(dy)
+    if dx >= 0:
+        a = 32 - c_div(32 * (dx - abs_y), dx + abs_y)
+    else:
+        a = 96 - c_div(32 * (dx + abs_y), abs_y - dx)
+
+    return -a & 0xFF if dy < 0 else a
+
+
+def _gen_led_geometry(info_data):
+    """Convert info.json content to g_led_geometry, the per LED distance and angle relative to the center point
+    """
+    center_x, center_y = info_data['rgb_matrix'].get('center_point', [112, 32])
+
+    geometry = []
+    for led_data in info_data['rgb_matrix']['layout']:
+        dx = led_data.get('x', 0) - center_x
+        dy = led_data.get('y', 0) - center_y
+        geometry.append(f'{{{_sqrt16(dx * dx + dy * dy)}, {_atan2_8(dy, dx)}}}')
+
+    lines = []
+    lines.append('#ifdef RGB_MATRIX_GEOMETRY_TABLE')
+    lines.append(f'const led_geometry_t PROGMEM g_led_geometry[RGB_MATRIX_LED_COUNT] = {{ {", ".join(geometry)} }};')
+    lines.append('#endif')
+
+    return lines
+
+
 def _gen_led_config(info_data, config_type):
     """Convert info.json content to g_led_config
     """
@@ -56,6 +101,8 @@ def _gen_led_config(info_data, config_type):
     lines.append(f'  {{ {", ".join(pos)} }},')
     lines.append(f'  {{ {", ".join(flags)} }},')
     lines.append('};')
+    if config_type == 'rgb_matrix':
+        lines.extend(_gen_led_geometry(info_data))
     lines.append('#endif')
     lines.append('')
 
@@ -33,6 +33,10 @@
 #include <ch.h>
 #include <hal.h>
 
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#endif
+
 #ifndef I2C1_SCL_PIN
 #    define I2C1_SCL_PIN B6
 #endif
@@ -108,6 +112,25 @@ static const I2CConfig i2cconfig = {
 #endif
 };
 
+#ifdef I2C_ASYNC_ENABLE
+// Serializes the transfers of the main loop with those of the asynchronous
+// worker thread.
+static MUTEX_DECL(i2c_mutex);
+#    define i2c_lock() chMtxLock(&i2c_mutex)
+#    define i2c_unlock() chMtxUnlock(&i2c_mutex)
+#else
+#    define i2c_lock()
+#    define i2c_unlock()
+#endif
+
+/**
+ * @brief Takes ownership of the I2C peripheral and starts it.
+ */
+static void i2c_prologue(void) {
+    i2c_lock();
+    i2cStart(&I2C_DRIVER, &i2cconfig);
+}
+
 /**
  * @brief Handles any I2C error condition by stopping the I2C peripheral and
  * aborting any ongoing transactions. Furthermore ChibiOS status codes are
@@ -118,6 +141,7 @@ static const I2CConfig i2cconfig = {
  */
 static i2c_status_t i2c_epilogue(const msg_t status) {
     if (status == MSG_OK) {
+        i2c_unlock();
         return I2C_STATUS_SUCCESS;
     }
 
@@ -125,6 +149,7 @@ static i2c_status_t i2c_epilogue(const msg_t status) {
     // restarted because the bus is in an uncertain state." We also issue that
     // hard stop in case of any error.
     i2cStop(&I2C_DRIVER);
+    i2c_unlock();
 
     return status == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
 }
@@ -150,19 +175,19 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (address >> 1), data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
 
     uint8_t complete_packet[length + 1];
     for (uint16_t i = 0; i < length; i++) {
@@ -175,7 +200,7 @@ i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t*
 }
 
 i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
 
     uint8_t complete_packet[length + 2];
     for (uint16_t i = 0; i < length; i++) {
@@ -189,13 +214,13 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
 }
 
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
 }
 
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
+    i2c_prologue();
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
     msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
     return i2c_epilogue(status);
@@ -207,4 +232,34 @@ __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t ti
     // This approach may produce false negative results for I2C devices that do not respond to a register 0 read request.
     uint8_t data = 0;
     return i2c_read_register(address, 0, &data, sizeof(data), timeout);
-}
\ No newline at end of file
+}
+
+#ifdef I2C_ASYNC_ENABLE
+// The worker sleeps while the HAL moves the data, using DMA where the I2C
+// low level driver supports it, so the main loop keeps running meanwhile.
+static BSEMAPHORE_DECL(i2c_async_pending, true);
+static THD_WORKING_AREA(waI2CAsyncThread, 256);
+static THD_FUNCTION(I2CAsyncThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chBSemWait(&i2c_async_pending);
+        while (i2c_async_execute()) {
+        }
+    }
+}
+
+bool i2c_async_worker_start(void) {
+    chThdCreateStatic(waI2CAsyncThread, sizeof(waI2CAsyncThread), NORMALPRIO + 1, I2CAsyncThread, NULL);
+    return true;
+}
+
+void i2c_async_worker_notify(void) {
+    chBSemSignal(&i2c_async_pending);
+}
+
+void i2c_async_worker_wait(void) {
+    chThdSleep(1);
+}
+#endif
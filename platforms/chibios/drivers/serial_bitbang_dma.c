@@ -0,0 +1,337 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+ * Single wire soft serial for MCUs without a free USART. Instead of busy
+ * waiting for every bit, a timer update event paces a DMA stream that drives
+ * and samples the SOFT_SERIAL_PIN:
+ *  - when sending, every bit is precomputed as a BSRR word, which the DMA
+ *    copies into the GPIO port once per bit period.
+ *  - when receiving, the DMA copies the input data register into a circular
+ *    sample buffer SERIAL_BITBANG_DMA_OVERSAMPLING times per bit period,
+ *    which is decoded by the waiting thread whenever half of it is filled.
+ *
+ * Frames consist of a start bit, 8 data bits (LSB first), an odd parity bit
+ * and a stop bit. Every transmission starts with a break, whose falling edge
+ * starts the sampling of an idle receiver. The pin stays an open-drain output
+ * the whole time, a high level releases the line to the pull-up.
+ */
+
+#include "serial_bitbang_dma.h"
+#include "serial_protocol.h"
+#include "chibios_config.h"
+#include "util.h"
+
+#if !defined(MCU_STM32)
+#    error "The bitbang_dma serial driver only supports STM32 MCUs"
+#endif
+
+#define SERIAL_FRAME_BITS 11
+
+#if SERIAL_BITBANG_DMA_RX_SAMPLES < 2 * SERIAL_FRAME_BITS * SERIAL_BITBANG_DMA_OVERSAMPLING
+#    error "SERIAL_BITBANG_DMA_RX_SAMPLES must hold at least two frames"
+#endif
+
+#if defined(STM32F2XX) || defined(STM32F4XX) || defined(STM32F7XX)
+// In direct mode these DMA controllers use the peripheral width for memory as well
+#    define SERIAL_BITBANG_DMA_SAMPLE_PSIZE STM32_DMA_CR_PSIZE_HWORD
+#else
+// GPIOv1 registers only allow word accesses, the DMA truncates them to the sample size
+#    define SERIAL_BITBANG_DMA_SAMPLE_PSIZE STM32_DMA_CR_PSIZE_WORD
+#endif
+
+#if defined(USE_GPIOV1)
+#    define SERIAL_BITBANG_DMA_PIN_MODE PAL_MODE_OUTPUT_OPENDRAIN
+#else
+#    define SERIAL_BITBANG_DMA_PIN_MODE (PAL_MODE_OUTPUT_OPENDRAIN | PAL_PUPDR_PULLUP | PAL_OUTPUT_SPEED_HIGHEST)
+#endif
+
+#define SERIAL_PORT ((stm32_gpio_t *)PAL_PORT(SOFT_SERIAL_PIN))
+#define SERIAL_MASK (1U << PAL_PAD(SOFT_SERIAL_PIN))
+#define SERIAL_HIGH (SERIAL_MASK)
+#define SERIAL_LOW (SERIAL_MASK << 16)
+
+#define SERIAL_TX_PERIOD (SERIAL_BITBANG_DMA_TIMER_FREQUENCY / SERIAL_BITBANG_DMA_SPEED)
+#define SERIAL_RX_PERIOD (SERIAL_BITBANG_DMA_TIMER_FREQUENCY / (SERIAL_BITBANG_DMA_SPEED * SERIAL_BITBANG_DMA_OVERSAMPLING))
+
+// Break, mark after break, the frames and a trailing idle bit
+#define SERIAL_TX_BITS (SERIAL_BITBANG_DMA_BREAK_BITS + 1 + SERIAL_BITBANG_DMA_TX_CHUNK * SERIAL_FRAME_BITS + 1)
+
+static uint32_t tx_bits[SERIAL_TX_BITS];
+static uint16_t rx_samples[SERIAL_BITBANG_DMA_RX_SAMPLES];
+
+static binary_semaphore_t tx_done;
+static binary_semaphore_t rx_ready;
+
+static volatile bool     rx_active  = false;
+static volatile uint32_t rx_written = 0;     // samples of the completed buffer halves since sampling started
+static uint32_t          rx_read    = 0;     // next sample to decode
+static bool              rx_break   = false; // the decoder waits for the line to be released
+
+static const GPTConfig gpt_config = {
+    .frequency = SERIAL_BITBANG_DMA_TIMER_FREQUENCY,
+    .callback  = NULL,
+    .cr2       = 0,
+    .dier      = TIM_DIER_UDE, // DMA request on every update event
+};
+
+static void dma_callback(void *param, uint32_t flags) {
+    (void)param;
+
+    osalSysLockFromISR();
+    if (rx_active) {
+        if (flags & STM32_DMA_ISR_HTIF) {
+            rx_written += SERIAL_BITBANG_DMA_RX_SAMPLES / 2;
+        }
+        if (flags & STM32_DMA_ISR_TCIF) {
+            rx_written += SERIAL_BITBANG_DMA_RX_SAMPLES / 2;
+        }
+        chBSemSignalI(&rx_ready);
+    } else if (flags & STM32_DMA_ISR_TCIF) {
+        chBSemSignalI(&tx_done);
+    }
+    osalSysUnlockFromISR();
+}
+
+/**
+ * @brief Starts sampling on the falling edge of a break.
+ */
+static void edge_callback(void *arg) {
+    (void)arg;
+
+    osalSysLockFromISR();
+    palDisableLineEventI(SOFT_SERIAL_PIN);
+    dmaStreamEnable(SERIAL_BITBANG_DMA_STREAM);
+    gptStartContinuousI(&SERIAL_BITBANG_DMA_GPT_DRIVER, SERIAL_RX_PERIOD);
+    osalSysUnlockFromISR();
+}
+
+/**
+ * @brief Prepares the DMA stream for receiving, sampling starts with the next
+ * falling edge.
+ */
+static void rx_arm(void) {
+    rx_written = 0;
+    rx_read    = 0;
+    rx_break   = true;
+
+    dmaStreamSetPeripheral(SERIAL_BITBANG_DMA_STREAM, &SERIAL_PORT->IDR);
+    dmaStreamSetMemory0(SERIAL_BITBANG_DMA_STREAM, rx_samples);
+    dmaStreamSetTransactionSize(SERIAL_BITBANG_DMA_STREAM, SERIAL_BITBANG_DMA_RX_SAMPLES);
+    dmaStreamSetMode(SERIAL_BITBANG_DMA_STREAM, STM32_DMA_CR_CHSEL(SERIAL_BITBANG_DMA_CHANNEL) | STM32_DMA_CR_DIR_P2M | SERIAL_BITBANG_DMA_SAMPLE_PSIZE | STM32_DMA_CR_MSIZE_HWORD | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_HTIE | STM32_DMA_CR_TCIE | STM32_DMA_CR_PL(3));
+
+    osalSysLock();
+    chBSemResetI(&rx_ready, true);
+    rx_active = true;
+    palEnableLineEventI(SOFT_SERIAL_PIN, PAL_EVENT_MODE_FALLING_EDGE);
+    palSetLineCallbackI(SOFT_SERIAL_PIN, edge_callback, NULL);
+    osalSysUnlock();
+}
+
+static void rx_stop(void) {
+    osalSysLock();
+    palDisableLineEventI(SOFT_SERIAL_PIN);
+    osalSysUnlock();
+
+    gptStopTimer(&SERIAL_BITBANG_DMA_GPT_DRIVER);
+    dmaStreamDisable(SERIAL_BITBANG_DMA_STREAM);
+    rx_active = false;
+}
+
+static inline bool rx_sample(uint32_t index) {
+    return rx_samples[index % SERIAL_BITBANG_DMA_RX_SAMPLES] & SERIAL_MASK;
+}
+
+/**
+ * @brief Decodes the next frame from the received samples.
+ *
+ * @return 1 if a byte was decoded, 0 if more samples are needed, -1 on
+ * framing, parity or overrun errors.
+ */
+static int rx_decode(uint8_t *byte) {
+    osalSysLock();
+    // Completed halves, plus the progress of the DMA within the current one
+    uint32_t position = SERIAL_BITBANG_DMA_RX_SAMPLES - dmaStreamGetTransactionSize(SERIAL_BITBANG_DMA_STREAM);
+    uint32_t written  = rx_written;
+    written += (position + SERIAL_BITBANG_DMA_RX_SAMPLES - written % SERIAL_BITBANG_DMA_RX_SAMPLES) % SERIAL_BITBANG_DMA_RX_SAMPLES;
+    osalSysUnlock();
+
+    // Leave a frame of headroom for the samples the DMA writes while decoding
+    if (written - rx_read > SERIAL_BITBANG_DMA_RX_SAMPLES - SERIAL_FRAME_BITS * SERIAL_BITBANG_DMA_OVERSAMPLING) {
+        serial_dprintf("SPLIT: sample buffer overrun\n");
+        return -1;
+    }
+
+    while (true) {
+        if (rx_break) {
+            while (rx_read < written && !rx_sample(rx_read)) {
+                rx_read++;
+            }
+            if (rx_read == written) {
+                return 0;
+            }
+            rx_break = false;
+        }
+
+        // Idle line until the start bit
+        while (rx_read < written && rx_sample(rx_read)) {
+            rx_read++;
+        }
+
+        uint32_t center = rx_read + SERIAL_BITBANG_DMA_OVERSAMPLING / 2;
+        if (center + (SERIAL_FRAME_BITS - 1) * SERIAL_BITBANG_DMA_OVERSAMPLING >= written) {
+            return 0;
+        }
+        if (rx_sample(center)) {
+            // Too short for a start bit
+            rx_read++;
+            continue;
+        }
+
+        uint8_t data = 0;
+        uint8_t ones = 0;
+        for (uint8_t bit = 0; bit < 9; bit++) {
+            bool level = rx_sample(center + (bit + 1) * SERIAL_BITBANG_DMA_OVERSAMPLING);
+            if (bit < 8) {
+                data |= level << bit;
+            }
+            ones += level;
+        }
+
+        rx_read = center + (SERIAL_FRAME_BITS - 1) * SERIAL_BITBANG_DMA_OVERSAMPLING;
+        if (!rx_sample(rx_read)) {
+            if (ones == 0) {
+                // Break in front of the next transmission
+                rx_break = true;
+                continue;
+            }
+            serial_dprintf("SPLIT: framing error\n");
+            return -1;
+        }
+        if (!(ones & 1)) {
+            serial_dprintf("SPLIT: parity error\n");
+            return -1;
+        }
+
+        *byte = data;
+        return 1;
+    }
+}
+
+static bool receive(uint8_t *destination, const size_t size, sysinterval_t timeout) {
+    if (!rx_active) {
+        rx_arm();
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        int result;
+        while ((result = rx_decode(&destination[i])) == 0) {
+            if (chBSemWaitTimeout(&rx_ready, timeout) != MSG_OK) {
+                return false;
+            }
+        }
+        if (result < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t *tx_encode(uint32_t *bit, uint8_t data) {
+    uint8_t ones = 0;
+
+    *bit++ = SERIAL_LOW;
+    for (uint8_t i = 0; i < 8; i++) {
+        bool level = data & (1 << i);
+        *bit++     = level ? SERIAL_HIGH : SERIAL_LOW;
+        ones += level;
+    }
+    *bit++ = (ones & 1) ? SERIAL_LOW : SERIAL_HIGH;
+    *bit++ = SERIAL_HIGH;
+    return bit;
+}
+
+static bool tx_run(size_t count) {
+    dmaStreamSetPeripheral(SERIAL_BITBANG_DMA_STREAM, &SERIAL_PORT->BSRR);
+    dmaStreamSetMemory0(SERIAL_BITBANG_DMA_STREAM, tx_bits);
+    dmaStreamSetTransactionSize(SERIAL_BITBANG_DMA_STREAM, count);
+    dmaStreamSetMode(SERIAL_BITBANG_DMA_STREAM, STM32_DMA_CR_CHSEL(SERIAL_BITBANG_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | STM32_DMA_CR_PSIZE_WORD | STM32_DMA_CR_MSIZE_WORD | STM32_DMA_CR_MINC | STM32_DMA_CR_TCIE | STM32_DMA_CR_PL(3));
+
+    chBSemReset(&tx_done, true);
+    dmaStreamEnable(SERIAL_BITBANG_DMA_STREAM);
+    gptStartContinuous(&SERIAL_BITBANG_DMA_GPT_DRIVER, SERIAL_TX_PERIOD);
+
+    // The CPU is free for other threads until the last bit has been written
+    bool okay = chBSemWaitTimeout(&tx_done, TIME_MS2I(SERIAL_BITBANG_DMA_TIMEOUT)) == MSG_OK;
+
+    gptStopTimer(&SERIAL_BITBANG_DMA_GPT_DRIVER);
+    dmaStreamDisable(SERIAL_BITBANG_DMA_STREAM);
+    return okay;
+}
+
+bool serial_transport_send(const uint8_t *source, const size_t size) {
+    // Half duplex, the line is ours until the other side answers
+    if (rx_active) {
+        rx_stop();
+    }
+
+    for (size_t offset = 0; offset < size; offset += SERIAL_BITBANG_DMA_TX_CHUNK) {
+        uint32_t *bit = tx_bits;
+        if (offset == 0) {
+            for (uint8_t i = 0; i < SERIAL_BITBANG_DMA_BREAK_BITS; i++) {
+                *bit++ = SERIAL_LOW;
+            }
+            *bit++ = SERIAL_HIGH;
+        }
+
+        size_t count = MIN(size - offset, SERIAL_BITBANG_DMA_TX_CHUNK);
+        for (size_t i = 0; i < count; i++) {
+            bit = tx_encode(bit, source[offset + i]);
+        }
+        // The DMA completes with the last word, keep the stop bit for a full period
+        *bit++ = SERIAL_HIGH;
+
+        if (unlikely(!tx_run(bit - tx_bits))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool serial_transport_receive(uint8_t *destination, const size_t size) {
+    return receive(destination, size, TIME_MS2I(SERIAL_BITBANG_DMA_TIMEOUT));
+}
+
+bool serial_transport_receive_blocking(uint8_t *destination, const size_t size) {
+    return receive(destination, size, TIME_INFINITE);
+}
+
+void serial_transport_driver_clear(void) {
+    if (rx_active) {
+        rx_stop();
+    }
+}
+
+static void bitbang_dma_init(void) {
+    palSetLineMode(SOFT_SERIAL_PIN, SERIAL_BITBANG_DMA_PIN_MODE);
+    palSetLine(SOFT_SERIAL_PIN);
+
+    chBSemObjectInit(&tx_done, true);
+    chBSemObjectInit(&rx_ready, true);
+
+    dmaStreamAlloc(SERIAL_BITBANG_DMA_STREAM - STM32_DMA_STREAM(0), 10, dma_callback, NULL);
+#if (STM32_DMA_SUPPORTS_DMAMUX == TRUE)
+    // If the MCU has a DMAMUX we need to assign the correct resource
+    dmaSetRequestSource(SERIAL_BITBANG_DMA_STREAM, SERIAL_BITBANG_DMA_DMAMUX_ID);
+#endif
+
+    gptStart(&SERIAL_BITBANG_DMA_GPT_DRIVER, &gpt_config);
+}
+
+void serial_transport_driver_slave_init(void) {
+    bitbang_dma_init();
+}
+
+void serial_transport_driver_master_init(void) {
+    bitbang_dma_init();
+}
@@ -0,0 +1,89 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "serial.h"
+#include <hal.h>
+
+#if !defined(SELECT_SOFT_SERIAL_SPEED)
+#    define SELECT_SOFT_SERIAL_SPEED 1
+#endif
+
+#if defined(SERIAL_BITBANG_DMA_SPEED)
+// Allow advanced users to directly set SERIAL_BITBANG_DMA_SPEED
+#elif SELECT_SOFT_SERIAL_SPEED == 0
+#    define SERIAL_BITBANG_DMA_SPEED 460800
+#elif SELECT_SOFT_SERIAL_SPEED == 1
+#    define SERIAL_BITBANG_DMA_SPEED 230400
+#elif SELECT_SOFT_SERIAL_SPEED == 2
+#    define SERIAL_BITBANG_DMA_SPEED 115200
+#elif SELECT_SOFT_SERIAL_SPEED == 3
+#    define SERIAL_BITBANG_DMA_SPEED 57600
+#elif SELECT_SOFT_SERIAL_SPEED == 4
+#    define SERIAL_BITBANG_DMA_SPEED 38400
+#elif SELECT_SOFT_SERIAL_SPEED == 5
+#    define SERIAL_BITBANG_DMA_SPEED 19200
+#else
+#    error invalid SELECT_SOFT_SERIAL_SPEED value
+#endif
+
+#if !defined(SERIAL_BITBANG_DMA_TIMEOUT)
+#    define SERIAL_BITBANG_DMA_TIMEOUT 20
+#endif
+
+/* Timer whose update event paces the DMA transfers, its clock frequency and
+ * the DMA stream that is triggered by the update event. */
+#if !defined(SERIAL_BITBANG_DMA_GPT_DRIVER)
+#    define SERIAL_BITBANG_DMA_GPT_DRIVER GPTD3
+#endif
+
+#if !defined(SERIAL_BITBANG_DMA_TIMER_FREQUENCY)
+#    define SERIAL_BITBANG_DMA_TIMER_FREQUENCY (CPU_CLOCK / 2)
+#endif
+
+#if !defined(SERIAL_BITBANG_DMA_STREAM)
+#    define SERIAL_BITBANG_DMA_STREAM STM32_DMA1_STREAM3 // DMA Stream for TIM3_UP
+#endif
+
+#if !defined(SERIAL_BITBANG_DMA_CHANNEL)
+#    define SERIAL_BITBANG_DMA_CHANNEL 3 // DMA Channel for TIM3_UP
+#endif
+
+#if (STM32_DMA_SUPPORTS_DMAMUX == TRUE) && !defined(SERIAL_BITBANG_DMA_DMAMUX_ID)
+#    error "please consult your MCU's datasheet and specify in your config.h: #define SERIAL_BITBANG_DMA_DMAMUX_ID STM32_DMAMUX1_TIM?_UP"
+#endif
+
+/* Number of line samples taken per bit while receiving. */
+#if !defined(SERIAL_BITBANG_DMA_OVERSAMPLING)
+#    define SERIAL_BITBANG_DMA_OVERSAMPLING 4
+#endif
+
+/* Size of the circular receive sample buffer, every half of it is handed to
+ * the decoder once it has been filled. */
+#if !defined(SERIAL_BITBANG_DMA_RX_SAMPLES)
+#    define SERIAL_BITBANG_DMA_RX_SAMPLES 256
+#endif
+
+/* Number of bytes encoded into the transmit bit buffer at once. */
+#if !defined(SERIAL_BITBANG_DMA_TX_CHUNK)
+#    define SERIAL_BITBANG_DMA_TX_CHUNK 8
+#endif
+
+/* Length of the break that precedes every transmission, which wakes up an idle
+ * receiver. Has to cover at least a whole frame. */
+#if !defined(SERIAL_BITBANG_DMA_BREAK_BITS)
+#    define SERIAL_BITBANG_DMA_BREAK_BITS 12
+#endif
+
+#if SERIAL_BITBANG_DMA_OVERSAMPLING < 3
+#    error "SERIAL_BITBANG_DMA_OVERSAMPLING must be at least 3"
+#endif
+
+#if SERIAL_BITBANG_DMA_RX_SAMPLES % 2 != 0
+#    error "SERIAL_BITBANG_DMA_RX_SAMPLES must be even"
+#endif
+
+#if SERIAL_BITBANG_DMA_BREAK_BITS < 11
+#    error "SERIAL_BITBANG_DMA_BREAK_BITS must be at least 11"
+#endif
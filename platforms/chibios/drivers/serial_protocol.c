@@ -10,6 +10,54 @@
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
+/**
+ * @brief Bundles and deltas are length prefixed, only the used part of their
+ * buffers is transferred.
+ */
+static inline bool initiator2target_length_prefixed(uint8_t transaction_id) {
+#ifdef SPLIT_TRANSACTION_DELTA
+    if (transaction_id == PUT_DELTA) {
+        return true;
+    }
+#endif
+#ifdef SPLIT_TRANSACTION_BUNDLE
+    if (transaction_id == EXECUTE_BUNDLE) {
+        return true;
+    }
+#endif
+    return false;
+}
+
+static inline bool target2initiator_length_prefixed(uint8_t transaction_id) {
+#ifdef SPLIT_TRANSACTION_BUNDLE
+    if (transaction_id == EXECUTE_BUNDLE) {
+        return true;
+    }
+#endif
+    return false;
+}
+
+static inline bool send_buffer(bool length_prefixed, const uint8_t* buffer, size_t size) {
+    if (length_prefixed && buffer[0] < size) {
+        size = 1 + buffer[0];
+    }
+    return serial_transport_send(buffer, size);
+}
+
+static inline bool receive_buffer(bool length_prefixed, uint8_t* buffer, size_t size) {
+    if (length_prefixed) {
+        if (unlikely(!serial_transport_receive(buffer, 1) || buffer[0] >= size)) {
+            return false;
+        }
+        size = buffer[0];
+        buffer++;
+        if (size == 0) {
+            return true;
+        }
+    }
+    return serial_transport_receive(buffer, size);
+}
+
 /**
  * @brief This thread runs on the slave and responds to transactions initiated
  * by the master.
@@ -66,14 +114,14 @@ static inline bool react_to_transaction(void) {
 
     /* Send back the handshake which is XORed as a simple checksum,
      to signal that the slave is ready to receive possible transaction buffers  */
-    transaction_id ^= NUM_TOTAL_TRANSACTIONS;
-    if (unlikely(!serial_transport_send(&transaction_id, sizeof(transaction_id)))) {
+    uint8_t transaction_id_shake = transaction_id ^ NUM_TOTAL_TRANSACTIONS;
+    if (unlikely(!serial_transport_send(&transaction_id_shake, sizeof(transaction_id_shake)))) {
         return false;
     }
 
     /* Receive transaction buffer from the master. If this transaction requires it.*/
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        if (unlikely(!receive_buffer(initiator2target_length_prefixed(transaction_id), split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
             return false;
         }
     }
@@ -85,7 +133,7 @@ static inline bool react_to_transaction(void) {
 
     /* Send transaction buffer to the master. If this transaction requires it. */
     if (transaction->target2initiator_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+        if (unlikely(!send_buffer(target2initiator_length_prefixed(transaction_id), split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
             return false;
         }
     }
@@ -140,7 +188,7 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     /* Send transaction buffer to the slave. If this transaction requires it. */
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        if (unlikely(!send_buffer(initiator2target_length_prefixed(transaction_id), split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
             serial_dprintf("SPLIT: sending buffer failed\n");
             return false;
         }
@@ -148,7 +196,7 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     /* Receive transaction buffer from the slave. If this transaction requires it. */
     if (transaction->target2initiator_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+        if (unlikely(!receive_buffer(target2initiator_length_prefixed(transaction_id), split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
             serial_dprintf("SPLIT: receiving buffer failed\n");
             return false;
         }
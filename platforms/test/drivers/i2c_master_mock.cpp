@@ -0,0 +1,62 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_master_mock.hpp"
+
+i2c_status_t MockI2C::transfer(uint8_t address, const uint8_t* tx, uint16_t tx_length, uint8_t* rx, uint16_t rx_length, uint16_t timeout) {
+    transfers.push_back({address, std::vector<uint8_t>(tx, tx + tx_length), rx_length, timeout});
+
+    std::vector<uint8_t> response;
+    if (rx_length > 0 && !responses.empty()) {
+        response = std::move(responses.front());
+        responses.pop_front();
+    }
+    for (uint16_t i = 0; i < rx_length; i++) {
+        rx[i] = i < response.size() ? response[i] : 0;
+    }
+
+    i2c_status_t status = I2C_STATUS_SUCCESS;
+    if (!statuses.empty()) {
+        status = statuses.front();
+        statuses.pop_front();
+    }
+    return status;
+}
+
+extern "C" {
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    return MockI2C::instance().transfer(address, data, length, nullptr, 0, timeout);
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    return MockI2C::instance().transfer(address, nullptr, 0, data, length, timeout);
+}
+
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    std::vector<uint8_t> packet{regaddr};
+    packet.insert(packet.end(), data, data + length);
+    return MockI2C::instance().transfer(devaddr, packet.data(), packet.size(), nullptr, 0, timeout);
+}
+
+i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    std::vector<uint8_t> packet{(uint8_t)(regaddr >> 8), (uint8_t)(regaddr & 0xFF)};
+    packet.insert(packet.end(), data, data + length);
+    return MockI2C::instance().transfer(devaddr, packet.data(), packet.size(), nullptr, 0, timeout);
+}
+
+i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    return MockI2C::instance().transfer(devaddr, &regaddr, 1, data, length, timeout);
+}
+
+i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    uint8_t register_packet[2] = {(uint8_t)(regaddr >> 8), (uint8_t)(regaddr & 0xFF)};
+    return MockI2C::instance().transfer(devaddr, register_packet, 2, data, length, timeout);
+}
+
+i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
+    return MockI2C::instance().transfer(address, nullptr, 0, nullptr, 0, timeout);
+}
+}
@@ -0,0 +1,57 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+extern "C" {
+#include "i2c_master.h"
+}
+
+// A transfer as seen on the bus. Register addresses are part of the transmitted bytes, as they would be on the wire.
+struct MockI2CTransfer {
+    uint8_t              address;
+    std::vector<uint8_t> transmitted;
+    uint16_t             received_length;
+    uint16_t             timeout;
+};
+
+class MockI2C {
+   private:
+    MockI2C() = default;
+
+    std::vector<MockI2CTransfer>      transfers;
+    std::deque<i2c_status_t>          statuses;
+    std::deque<std::vector<uint8_t>> responses;
+
+   public:
+    static MockI2C& instance() {
+        static MockI2C mock;
+        return mock;
+    }
+
+    void reset() {
+        transfers.clear();
+        statuses.clear();
+        responses.clear();
+    }
+
+    // Status of the next transfer, transfers succeed once the scripted statuses are used up
+    void push_status(i2c_status_t status) {
+        statuses.push_back(status);
+    }
+
+    // Bytes returned by the next read, reads return zeroes once the scripted responses are used up
+    void push_response(std::vector<uint8_t> data) {
+        responses.push_back(std::move(data));
+    }
+
+    const std::vector<MockI2CTransfer>& log() const {
+        return transfers;
+    }
+
+    i2c_status_t transfer(uint8_t address, const uint8_t* tx, uint16_t tx_length, uint8_t* rx, uint16_t rx_length, uint16_t timeout);
+};
@@ -0,0 +1,198 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "i2c_master_mock.hpp"
+
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "i2c_async.h"
+}
+
+using Completion = std::pair<i2c_status_t, void*>;
+
+static std::vector<Completion> completions;
+
+static void record_completion(i2c_status_t status, void* context) {
+    completions.push_back({status, context});
+}
+
+class I2CAsync : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockI2C::instance().reset();
+        completions.clear();
+    }
+
+    void TearDown() override {
+        i2c_async_flush();
+    }
+};
+
+TEST_F(I2CAsync, TransfersRunInQueueOrder) {
+    const uint8_t a[] = {1, 2, 3};
+    const uint8_t b[] = {4};
+    const uint8_t c[] = {5};
+
+    EXPECT_TRUE(i2c_async_write_register(0x20, 0x10, a, sizeof(a), 100, NULL, NULL));
+    EXPECT_TRUE(i2c_async_transmit(0x22, b, sizeof(b), 100, NULL, NULL));
+    EXPECT_TRUE(i2c_async_write_register16(0x24, 0x1234, c, sizeof(c), 100, NULL, NULL));
+    EXPECT_TRUE(MockI2C::instance().log().empty());
+    EXPECT_FALSE(i2c_async_idle());
+
+    i2c_async_task();
+
+    auto& log = MockI2C::instance().log();
+    ASSERT_EQ(log.size(), 3);
+    EXPECT_EQ(log[0].address, 0x20);
+    EXPECT_EQ(log[0].transmitted, std::vector<uint8_t>({0x10, 1, 2, 3}));
+    EXPECT_EQ(log[1].address, 0x22);
+    EXPECT_EQ(log[1].transmitted, std::vector<uint8_t>({4}));
+    EXPECT_EQ(log[2].address, 0x24);
+    EXPECT_EQ(log[2].transmitted, std::vector<uint8_t>({0x12, 0x34, 5}));
+    EXPECT_TRUE(i2c_async_idle());
+}
+
+TEST_F(I2CAsync, TransmittedDataIsCopiedWhenQueued) {
+    uint8_t data[] = {1, 2};
+
+    EXPECT_TRUE(i2c_async_write_register(0x20, 0x00, data, sizeof(data), 100, NULL, NULL));
+    data[0] = 9;
+    data[1] = 9;
+    i2c_async_task();
+
+    auto& log = MockI2C::instance().log();
+    ASSERT_EQ(log.size(), 1);
+    EXPECT_EQ(log[0].transmitted, std::vector<uint8_t>({0x00, 1, 2}));
+}
+
+TEST_F(I2CAsync, CallbacksReceiveStatusAndContextInOrder) {
+    const uint8_t data[] = {0};
+    int           first, second;
+
+    MockI2C::instance().push_status(I2C_STATUS_SUCCESS);
+    MockI2C::instance().push_status(I2C_STATUS_TIMEOUT);
+    EXPECT_TRUE(i2c_async_transmit(0x20, data, sizeof(data), 100, record_completion, &first));
+    EXPECT_TRUE(i2c_async_transmit(0x20, data, sizeof(data), 100, record_completion, &second));
+    i2c_async_task();
+
+    EXPECT_EQ(completions, std::vector<Completion>({{I2C_STATUS_SUCCESS, &first}, {I2C_STATUS_TIMEOUT, &second}}));
+}
+
+TEST_F(I2CAsync, CallbacksAreOnlyInvokedFromMainLoop) {
+    const uint8_t data[] = {0};
+
+    EXPECT_TRUE(i2c_async_transmit(0x20, data, sizeof(data), 100, record_completion, NULL));
+    EXPECT_TRUE(i2c_async_transmit(0x20, data, sizeof(data), 100, record_completion, NULL));
+
+    // As a worker thread would
+    EXPECT_TRUE(i2c_async_execute());
+    EXPECT_EQ(MockI2C::instance().log().size(), 1);
+    EXPECT_TRUE(completions.empty());
+    EXPECT_FALSE(i2c_async_idle());
+
+    i2c_async_task();
+    EXPECT_EQ(MockI2C::instance().log().size(), 2);
+    EXPECT_EQ(completions.size(), 2);
+    EXPECT_FALSE(i2c_async_execute());
+}
+
+TEST_F(I2CAsync, ReadsCompleteBeforeCallback) {
+    uint8_t reg8[2]  = {0};
+    uint8_t reg16[1] = {0};
+    uint8_t raw[3]   = {0};
+
+    MockI2C::instance().push_response({0xAA, 0xBB});
+    MockI2C::instance().push_response({0xCC});
+    MockI2C::instance().push_response({0xDD, 0xEE, 0xFF});
+    EXPECT_TRUE(i2c_async_read_register(0x30, 0x05, reg8, sizeof(reg8), 100, record_completion, reg8));
+    EXPECT_TRUE(i2c_async_read_register16(0x32, 0x0102, reg16, sizeof(reg16), 100, record_completion, reg16));
+    EXPECT_TRUE(i2c_async_receive(0x34, raw, sizeof(raw), 100, record_completion, raw));
+    i2c_async_flush();
+
+    auto& log = MockI2C::instance().log();
+    ASSERT_EQ(log.size(), 3);
+    EXPECT_EQ(log[0].transmitted, std::vector<uint8_t>({0x05}));
+    EXPECT_EQ(log[0].received_length, 2);
+    EXPECT_EQ(log[1].transmitted, std::vector<uint8_t>({0x01, 0x02}));
+    EXPECT_EQ(log[1].received_length, 1);
+    EXPECT_TRUE(log[2].transmitted.empty());
+    EXPECT_EQ(log[2].received_length, 3);
+
+    EXPECT_EQ(std::vector<uint8_t>(reg8, reg8 + 2), std::vector<uint8_t>({0xAA, 0xBB}));
+    EXPECT_EQ(reg16[0], 0xCC);
+    EXPECT_EQ(std::vector<uint8_t>(raw, raw + 3), std::vector<uint8_t>({0xDD, 0xEE, 0xFF}));
+    EXPECT_EQ(completions, std::vector<Completion>({{I2C_STATUS_SUCCESS, reg8}, {I2C_STATUS_SUCCESS, reg16}, {I2C_STATUS_SUCCESS, raw}}));
+}
+
+TEST_F(I2CAsync, FullQueueRejectsTransfers) {
+    const uint8_t data[] = {0};
+
+    for (int i = 0; i < I2C_ASYNC_QUEUE_SIZE; i++) {
+        EXPECT_TRUE(i2c_async_transmit(0x20, data, sizeof(data), 100, NULL, NULL));
+    }
+    EXPECT_FALSE(i2c_async_transmit(0x20, data, sizeof(data), 100, NULL, NULL));
+
+    // A completed transfer frees its slot
+    EXPECT_TRUE(i2c_async_wait());
+    EXPECT_TRUE(i2c_async_transmit(0x20, data, sizeof(data), 100, NULL, NULL));
+    i2c_async_flush();
+    EXPECT_EQ(MockI2C::instance().log().size(), I2C_ASYNC_QUEUE_SIZE + 1);
+}
+
+TEST_F(I2CAsync, FullBufferRejectsTransfers) {
+    const uint8_t data[I2C_ASYNC_BUFFER_SIZE] = {0};
+
+    EXPECT_FALSE(i2c_async_transmit(0x20, data, I2C_ASYNC_BUFFER_SIZE + 1, 100, NULL, NULL));
+    EXPECT_TRUE(i2c_async_transmit(0x20, data, I2C_ASYNC_BUFFER_SIZE - 2, 100, NULL, NULL));
+    EXPECT_FALSE(i2c_async_transmit(0x20, data, 3, 100, NULL, NULL));
+    EXPECT_TRUE(i2c_async_transmit(0x20, data, 2, 100, NULL, NULL));
+    i2c_async_flush();
+    EXPECT_EQ(MockI2C::instance().log().size(), 2);
+}
+
+TEST_F(I2CAsync, BufferWrapsAroundWithoutCorruptingQueuedData) {
+    const uint8_t a[] = {1, 1, 1, 1, 1, 1, 1};
+    const uint8_t b[] = {2, 2, 2, 2, 2, 2, 2};
+    const uint8_t c[] = {3, 3, 3, 3, 3};
+
+    // a and b take up most of the buffer, c only fits at its start once a has completed
+    EXPECT_TRUE(i2c_async_transmit(0x20, a, sizeof(a), 100, NULL, NULL));
+    EXPECT_TRUE(i2c_async_transmit(0x20, b, sizeof(b), 100, NULL, NULL));
+    EXPECT_FALSE(i2c_async_transmit(0x20, c, sizeof(c), 100, NULL, NULL));
+    EXPECT_TRUE(i2c_async_wait());
+    EXPECT_TRUE(i2c_async_transmit(0x20, c, sizeof(c), 100, NULL, NULL));
+    i2c_async_flush();
+
+    auto& log = MockI2C::instance().log();
+    ASSERT_EQ(log.size(), 3);
+    EXPECT_EQ(log[0].transmitted, std::vector<uint8_t>(a, a + sizeof(a)));
+    EXPECT_EQ(log[1].transmitted, std::vector<uint8_t>(b, b + sizeof(b)));
+    EXPECT_EQ(log[2].transmitted, std::vector<uint8_t>(c, c + sizeof(c)));
+}
+
+static void queue_follow_up(i2c_status_t status, void* context) {
+    const uint8_t data[] = {0x42};
+    EXPECT_TRUE(i2c_async_transmit(0x26, data, sizeof(data), 100, record_completion, context));
+}
+
+TEST_F(I2CAsync, CallbacksCanQueueTransfers) {
+    const uint8_t data[] = {0x41};
+
+    EXPECT_TRUE(i2c_async_transmit(0x24, data, sizeof(data), 100, queue_follow_up, NULL));
+    i2c_async_flush();
+
+    auto& log = MockI2C::instance().log();
+    ASSERT_EQ(log.size(), 2);
+    EXPECT_EQ(log[0].transmitted, std::vector<uint8_t>({0x41}));
+    EXPECT_EQ(log[1].transmitted, std::vector<uint8_t>({0x42}));
+    EXPECT_EQ(completions.size(), 1);
+    EXPECT_TRUE(i2c_async_idle());
+}
+
+TEST_F(I2CAsync, WaitReturnsFalseWhenIdle) {
+    EXPECT_TRUE(i2c_async_idle());
+    EXPECT_FALSE(i2c_async_wait());
+}
@@ -23,3 +23,10 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+i2c_async_DEFS := -DI2C_ASYNC_ENABLE -DI2C_ASYNC_QUEUE_SIZE=4 -DI2C_ASYNC_BUFFER_SIZE=16
+
+i2c_async_SRC := \
+	$(TOP_DIR)/drivers/i2c_async.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/i2c_async_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/drivers/i2c_master_mock.cpp
@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -7,6 +8,11 @@
 #include "util.h"
 #include "action_layer.h"
 
+#ifdef EFFECTIVE_KEYMAP_CACHE
+#    include "matrix.h"
+#    include "keymap_common.h"
+#endif
+
 /** \brief Default Layer State
  */
 layer_state_t default_layer_state = 0;
@@ -37,6 +43,7 @@ static void default_layer_state_set(layer_state_t state) {
     default_layer_debug();
     ac_dprintf(" to ");
     default_layer_state = state;
+    effective_keymap_cache_clear();
     default_layer_debug();
     ac_dprintf("\n");
 #if defined(STRICT_LAYER_RELEASE)
@@ -117,6 +124,7 @@ void layer_state_set(layer_state_t state) {
     layer_debug();
     ac_dprintf(" to ");
     layer_state = state;
+    effective_keymap_cache_clear();
     layer_debug();
     ac_dprintf("\n");
 #    if defined(STRICT_LAYER_RELEASE)
@@ -216,6 +224,91 @@ void layer_debug(void) {
 }
 #endif
 
+#ifndef NO_ACTION_LAYER
+/** \brief Resolve layer
+ *
+ * Walks the active layers to find the topmost one where the key is not transparent
+ */
+static uint8_t resolve_layer(keypos_t key) {
+    action_t action;
+    action.code = ACTION_TRANSPARENT;
+
+    layer_state_t layers = layer_state | default_layer_state;
+    /* check top layer first */
+    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+        if (layers & ((layer_state_t)1 << i)) {
+            action = action_for_key(i, key);
+            if (action.code != ACTION_TRANSPARENT) {
+                return i;
+            }
+        }
+    }
+    /* fall back to layer 0 */
+    return 0;
+}
+#endif
+
+#if defined(EFFECTIVE_KEYMAP_CACHE) && !defined(NO_ACTION_LAYER)
+/** \brief effective keymap cache
+ *
+ * Topmost non-transparent layer and its keycode for every matrix position. Entries are resolved on first use and
+ * dropped whenever the layer state or the keymap changes, so a lookup only walks the active layers once per change.
+ */
+static uint8_t      effective_keymap_layers[MATRIX_ROWS][MATRIX_COLS];
+static uint16_t     effective_keymap_keycodes[MATRIX_ROWS][MATRIX_COLS];
+static matrix_row_t effective_keymap_valid[MATRIX_ROWS] = {0};
+
+/** \brief Effective keymap cache clear
+ *
+ * Drops every cached entry
+ */
+void effective_keymap_cache_clear(void) {
+    memset(effective_keymap_valid, 0, sizeof(effective_keymap_valid));
+}
+
+/** \brief Effective keymap cache clear key
+ *
+ * Drops the cached entry of a single key, to be used when its keycode changes on any layer
+ */
+void effective_keymap_cache_clear_key(keypos_t key) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        effective_keymap_valid[key.row] &= ~(MATRIX_ROW_SHIFTER << key.col);
+    }
+}
+
+/** \brief Effective keymap cache lookup
+ *
+ * Returns true and fills in the cached layer of a matrix position, resolving it first if needed
+ */
+static bool effective_keymap_cache_lookup(keypos_t key, uint8_t *layer) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) {
+        return false;
+    }
+
+    const matrix_row_t col_mask = MATRIX_ROW_SHIFTER << key.col;
+    if (!(effective_keymap_valid[key.row] & col_mask)) {
+        const uint8_t layer_found                   = resolve_layer(key);
+        effective_keymap_layers[key.row][key.col]   = layer_found;
+        effective_keymap_keycodes[key.row][key.col] = keymap_key_to_keycode(layer_found, key);
+        effective_keymap_valid[key.row] |= col_mask;
+    }
+
+    *layer = effective_keymap_layers[key.row][key.col];
+    return true;
+}
+
+/** \brief Effective keymap keycode
+ *
+ * Same as keymap_key_to_keycode(), but served from the cache when the key has already been resolved to the given layer
+ */
+uint16_t effective_keymap_keycode(uint8_t layer, keypos_t key) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS && (effective_keymap_valid[key.row] & (MATRIX_ROW_SHIFTER << key.col)) && effective_keymap_layers[key.row][key.col] == layer) {
+        return effective_keymap_keycodes[key.row][key.col];
+    }
+    return keymap_key_to_keycode(layer, key);
+}
+#endif
+
 #if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
 /** \brief source layer cache
  */
@@ -322,21 +415,13 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
  */
 uint8_t layer_switch_get_layer(keypos_t key) {
 #ifndef NO_ACTION_LAYER
-    action_t action;
-    action.code = ACTION_TRANSPARENT;
-
-    layer_state_t layers = layer_state | default_layer_state;
-    /* check top layer first */
-    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
-        if (layers & ((layer_state_t)1 << i)) {
-            action = action_for_key(i, key);
-            if (action.code != ACTION_TRANSPARENT) {
-                return i;
-            }
-        }
+#    ifdef EFFECTIVE_KEYMAP_CACHE
+    uint8_t cached_layer;
+    if (effective_keymap_cache_lookup(key, &cached_layer)) {
+        return cached_layer;
     }
-    /* fall back to layer 0 */
-    return 0;
+#    endif
+    return resolve_layer(key);
 #else
     return get_highest_layer(default_layer_state);
 #endif
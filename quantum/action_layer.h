@@ -155,6 +155,17 @@ layer_state_t update_tri_layer_state(layer_state_t state, uint8_t layer1, uint8_
 #    define update_tri_layer_state(state, layer1, layer2, layer3) (void)state
 #endif
 
+/* effective keymap cache */
+#if defined(EFFECTIVE_KEYMAP_CACHE) && !defined(NO_ACTION_LAYER)
+void     effective_keymap_cache_clear(void);
+void     effective_keymap_cache_clear_key(keypos_t key);
+uint16_t effective_keymap_keycode(uint8_t layer, keypos_t key);
+#else
+#    define effective_keymap_cache_clear()
+#    define effective_keymap_cache_clear_key(key) (void)key
+#    define effective_keymap_keycode(layer, key) keymap_key_to_keycode(layer, key)
+#endif
+
 /* pressed actions cache */
 #if !defined(NO_ACTION_LAYER) && !defined(STRICT_LAYER_RELEASE)
 
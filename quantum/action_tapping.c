@@ -1,10 +1,12 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "keycode.h"
+#include "matrix.h"
 #include "timer.h"
 
 #ifndef NO_ACTION_TAPPING
@@ -20,8 +22,8 @@
 #    else
 #        define IS_TAPPING_RECORD(r) (KEYEQ(tapping_key.event.key, (r->event.key)) && tapping_key.keycode == r->keycode)
 #    endif
-#    define WITHIN_TAPPING_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
-#    define WITHIN_QUICK_TAP_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_QUICK_TAP_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
+#    define WITHIN_TAPPING_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < tapping_key_config.tapping_term)
+#    define WITHIN_QUICK_TAP_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < tapping_key_config.quick_tap_term)
 
 #    ifdef DYNAMIC_TAPPING_TERM_ENABLE
 uint16_t g_tapping_term = TAPPING_TERM;
@@ -59,13 +61,41 @@ __attribute__((weak)) bool get_hold_on_other_key_press(uint16_t keycode, keyreco
 #        include "process_auto_shift.h"
 #    endif
 
+#    ifdef TAP_HOLD_TABLE
+#        include "quantum_keycodes.h"
+#        include "util.h"
+#    endif
+
 static keyrecord_t tapping_key                         = {};
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+// Matrix keys with a press or release event in the waiting buffer, so that lookups do not need to walk the buffer
+static matrix_row_t waiting_buffer_pressed_keys[MATRIX_ROWS]  = {};
+static matrix_row_t waiting_buffer_released_keys[MATRIX_ROWS] = {};
+static uint8_t      waiting_buffer_pressed_count              = 0;
+static uint8_t      waiting_buffer_other_count                = 0; // events of keys outside the matrix
+
+// Settings of the current tapping key, resolved once when it is captured rather than on every tick
+typedef struct {
+    uint16_t tapping_term;
+    uint16_t quick_tap_term;
+    bool     permissive_hold;
+    bool     hold_on_other_key_press;
+} tapping_key_config_t;
+
+static tapping_key_config_t tapping_key_config = {};
+
+#    ifdef TAP_HOLD_TABLE
+static const tap_hold_table_entry_t PROGMEM tap_hold_table[] = TAP_HOLD_TABLE;
+#    endif
+
 static bool process_tapping(keyrecord_t *record);
+static void tapping_key_resolve(void);
+static bool waiting_buffer_full(void);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_deq(void);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
@@ -98,7 +128,7 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_deq()) {
         if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
             ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
             debug_record(waiting_buffer[waiting_buffer_tail]);
@@ -112,6 +142,31 @@ void action_tapping_process(keyrecord_t record) {
     }
 }
 
+#    ifdef WAITING_BUFFER_BACK_PRESSURE
+/** \brief Action Tapping Ready
+ *
+ * Returns false while the waiting buffer is full, in which case the event should be held back until it has drained.
+ * The last slot is reserved for the release of the tapping key, so that it can always settle the tapping key. After
+ * WAITING_BUFFER_BACK_PRESSURE_TIMEOUT events are accepted again, and an overflow clears all states.
+ */
+bool action_tapping_ready(keyevent_t event) {
+    static bool     holding    = false;
+    static uint16_t hold_start = 0;
+
+    uint8_t free_slots = (waiting_buffer_tail + WAITING_BUFFER_SIZE - waiting_buffer_head - 1) % WAITING_BUFFER_SIZE;
+    if (free_slots > 1 || (free_slots == 1 && tapping_key.event.pressed && !event.pressed && KEYEQ(event.key, tapping_key.event.key))) {
+        holding = false;
+        return true;
+    }
+    if (!holding) {
+        ac_dprintf("waiting_buffer: full, holding back key events\n");
+        holding    = true;
+        hold_start = timer_read();
+    }
+    return TIMER_DIFF_16(timer_read(), hold_start) >= WAITING_BUFFER_BACK_PRESSURE_TIMEOUT;
+}
+#    endif
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
@@ -141,16 +196,16 @@ void action_tapping_process(keyrecord_t record) {
 #        define TAP_IS_RETRO false
 #    endif
 
-#    ifdef PERMISSIVE_HOLD_PER_KEY
-#        define TAP_GET_PERMISSIVE_HOLD get_permissive_hold(tapping_keycode, &tapping_key)
+#    if defined(PERMISSIVE_HOLD_PER_KEY) || defined(TAP_HOLD_TABLE)
+#        define TAP_GET_PERMISSIVE_HOLD tapping_key_config.permissive_hold
 #    elif defined(PERMISSIVE_HOLD)
 #        define TAP_GET_PERMISSIVE_HOLD true
 #    else
 #        define TAP_GET_PERMISSIVE_HOLD false
 #    endif
 
-#    ifdef HOLD_ON_OTHER_KEY_PRESS_PER_KEY
-#        define TAP_GET_HOLD_ON_OTHER_KEY_PRESS get_hold_on_other_key_press(tapping_keycode, &tapping_key)
+#    if defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY) || defined(TAP_HOLD_TABLE)
+#        define TAP_GET_HOLD_ON_OTHER_KEY_PRESS tapping_key_config.hold_on_other_key_press
 #    elif defined(HOLD_ON_OTHER_KEY_PRESS)
 #        define TAP_GET_HOLD_ON_OTHER_KEY_PRESS true
 #    else
@@ -176,6 +231,7 @@ bool process_tapping(keyrecord_t *keyp) {
             // into the "pressed" tapping key state
             ac_dprintf("Tapping: Start(Press tap key).\n");
             tapping_key = *keyp;
+            tapping_key_resolve();
             process_record_tap_hint(&tapping_key);
             waiting_buffer_scan_tap();
             debug_tapping_key();
@@ -188,7 +244,7 @@ bool process_tapping(keyrecord_t *keyp) {
         return true;
     }
 
-#    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT)) || defined(PERMISSIVE_HOLD_PER_KEY) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY)
+#    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
     TAP_DEFINE_KEYCODE;
 #    endif
 
@@ -317,6 +373,7 @@ bool process_tapping(keyrecord_t *keyp) {
                         ac_dprintf("Tapping: Start while last tap(1).\n");
                     }
                     tapping_key = *keyp;
+                    tapping_key_resolve();
                     waiting_buffer_scan_tap();
                     debug_tapping_key();
                     return true;
@@ -368,6 +425,7 @@ bool process_tapping(keyrecord_t *keyp) {
                         ac_dprintf("Tapping: Start while last timeout tap(1).\n");
                     }
                     tapping_key = *keyp;
+                    tapping_key_resolve();
                     waiting_buffer_scan_tap();
                     debug_tapping_key();
                     return true;
@@ -400,11 +458,13 @@ bool process_tapping(keyrecord_t *keyp) {
                     }
                     // FIX: start new tap again
                     tapping_key = *keyp;
+                    tapping_key_resolve();
                     return true;
                 } else if (is_tap_record(keyp)) {
                     // Sequential tap can be interfered with other tap key.
                     ac_dprintf("Tapping: Start with interfering other tap.\n");
                     tapping_key = *keyp;
+                    tapping_key_resolve();
                     waiting_buffer_scan_tap();
                     debug_tapping_key();
                     return true;
@@ -432,16 +492,93 @@ bool process_tapping(keyrecord_t *keyp) {
     }
 }
 
+/** \brief Tapping key resolve
+ *
+ * Looks up the tap-hold settings of a newly captured tapping key, so that only the stored values are consulted while
+ * it is pending. Entries of TAP_HOLD_TABLE take precedence over the per key callbacks.
+ */
+static void tapping_key_resolve(void) {
+#    if defined(TAP_HOLD_TABLE) || defined(TAPPING_TERM_PER_KEY) || defined(QUICK_TAP_TERM_PER_KEY) || defined(PERMISSIVE_HOLD_PER_KEY) || defined(HOLD_ON_OTHER_KEY_PRESS_PER_KEY)
+    const uint16_t keycode = get_record_keycode(&tapping_key, false);
+#    endif
+
+#    ifdef TAP_HOLD_TABLE
+    for (uint8_t i = 0; i < ARRAY_SIZE(tap_hold_table); i++) {
+        if (pgm_read_word(&tap_hold_table[i].keycode) == keycode) {
+            uint8_t flags                              = pgm_read_byte(&tap_hold_table[i].flags);
+            tapping_key_config.tapping_term            = pgm_read_word(&tap_hold_table[i].tapping_term);
+            tapping_key_config.quick_tap_term          = pgm_read_word(&tap_hold_table[i].quick_tap_term);
+            tapping_key_config.permissive_hold         = flags & TAP_HOLD_PERMISSIVE_HOLD;
+            tapping_key_config.hold_on_other_key_press = flags & TAP_HOLD_HOLD_ON_OTHER_KEY_PRESS;
+            return;
+        }
+    }
+#    endif
+
+    tapping_key_config.tapping_term   = GET_TAPPING_TERM(keycode, &tapping_key);
+    tapping_key_config.quick_tap_term = GET_QUICK_TAP_TERM(keycode, &tapping_key);
+#    ifdef PERMISSIVE_HOLD_PER_KEY
+    tapping_key_config.permissive_hold = get_permissive_hold(keycode, &tapping_key);
+#    elif defined(PERMISSIVE_HOLD)
+    tapping_key_config.permissive_hold = true;
+#    else
+    tapping_key_config.permissive_hold = false;
+#    endif
+#    ifdef HOLD_ON_OTHER_KEY_PRESS_PER_KEY
+    tapping_key_config.hold_on_other_key_press = get_hold_on_other_key_press(keycode, &tapping_key);
+#    elif defined(HOLD_ON_OTHER_KEY_PRESS)
+    tapping_key_config.hold_on_other_key_press = true;
+#    else
+    tapping_key_config.hold_on_other_key_press = false;
+#    endif
+}
+
+static inline bool waiting_buffer_is_matrix_key(keypos_t key) {
+    return key.row < MATRIX_ROWS && key.col < MATRIX_COLS;
+}
+
+static inline matrix_row_t *waiting_buffer_keys(bool pressed) {
+    return pressed ? waiting_buffer_pressed_keys : waiting_buffer_released_keys;
+}
+
+/** \brief Walks the waiting buffer for an event of the given key and state
+ */
+static bool waiting_buffer_find(keypos_t key, bool pressed) {
+    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
+        if (KEYEQ(key, waiting_buffer[i].event.key) && pressed == waiting_buffer[i].event.pressed) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** \brief Checks for an event of the given key and state in the waiting buffer
+ *
+ * Constant time for matrix keys, other keys are only searched for while the buffer holds any.
+ */
+static bool waiting_buffer_contains(keypos_t key, bool pressed) {
+    if (waiting_buffer_is_matrix_key(key)) {
+        return waiting_buffer_keys(pressed)[key.row] & (MATRIX_ROW_SHIFTER << key.col);
+    }
+    return waiting_buffer_other_count && waiting_buffer_find(key, pressed);
+}
+
+/** \brief Waiting buffer full
+ */
+bool waiting_buffer_full(void) {
+    return (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail;
+}
+
 /** \brief Waiting buffer enq
  *
- * FIXME: Needs docs
+ * Appends a record, and marks its key in the lookup tables.
  */
 bool waiting_buffer_enq(keyrecord_t record) {
     if (IS_NOEVENT(record.event)) {
         return true;
     }
 
-    if ((waiting_buffer_head + 1) % WAITING_BUFFER_SIZE == waiting_buffer_tail) {
+    if (waiting_buffer_full()) {
         ac_dprintf("waiting_buffer_enq: Over flow.\n");
         return false;
     }
@@ -449,42 +586,68 @@ bool waiting_buffer_enq(keyrecord_t record) {
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
 
+    keypos_t key = record.event.key;
+    if (waiting_buffer_is_matrix_key(key)) {
+        waiting_buffer_keys(record.event.pressed)[key.row] |= MATRIX_ROW_SHIFTER << key.col;
+    } else {
+        waiting_buffer_other_count++;
+    }
+    if (record.event.pressed) {
+        waiting_buffer_pressed_count++;
+    }
+
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
 }
 
+/** \brief Waiting buffer deq
+ *
+ * Drops the oldest record. Its key stays marked if the buffer holds further events of the same key and state.
+ */
+void waiting_buffer_deq(void) {
+    keyevent_t event    = waiting_buffer[waiting_buffer_tail].event;
+    waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+
+    if (waiting_buffer_is_matrix_key(event.key)) {
+        if (!waiting_buffer_find(event.key, event.pressed)) {
+            waiting_buffer_keys(event.pressed)[event.key.row] &= ~(MATRIX_ROW_SHIFTER << event.key.col);
+        }
+    } else {
+        waiting_buffer_other_count--;
+    }
+    if (event.pressed) {
+        waiting_buffer_pressed_count--;
+    }
+}
+
 /** \brief Waiting buffer clear
  *
- * FIXME: Needs docs
+ * Empties the buffer and the lookup tables.
  */
 void waiting_buffer_clear(void) {
     waiting_buffer_head = 0;
     waiting_buffer_tail = 0;
+    memset(waiting_buffer_pressed_keys, 0, sizeof(waiting_buffer_pressed_keys));
+    memset(waiting_buffer_released_keys, 0, sizeof(waiting_buffer_released_keys));
+    waiting_buffer_pressed_count = 0;
+    waiting_buffer_other_count   = 0;
 }
 
 /** \brief Waiting buffer typed
  *
- * FIXME: Needs docs
+ * Checks whether the waiting buffer holds the opposite event of the same key, i.e. the key was typed.
  */
 bool waiting_buffer_typed(keyevent_t event) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
-            return true;
-        }
-    }
-    return false;
+    return waiting_buffer_contains(event.key, !event.pressed);
 }
 
 /** \brief Waiting buffer has anykey pressed
  *
- * FIXME: Needs docs
+ * Checks whether the waiting buffer holds any press event.
  */
 __attribute__((unused)) bool waiting_buffer_has_anykey_pressed(void) {
-    for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
-        if (waiting_buffer[i].event.pressed) return true;
-    }
-    return false;
+    return waiting_buffer_pressed_count > 0;
 }
 
 /** \brief Scan buffer for tapping
@@ -495,7 +658,8 @@ void waiting_buffer_scan_tap(void) {
     // early return if:
     // - tapping already is settled
     // - invalid state: tapping_key released && tap.count == 0
-    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed) {
+    // - the release of the tapping key is not in the buffer
+    if ((tapping_key.tap.count > 0) || !tapping_key.event.pressed || !waiting_buffer_contains(tapping_key.event.key, false)) {
         return;
     }
 
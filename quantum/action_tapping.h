@@ -32,12 +32,23 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* number of key events buffered while a tap-hold key is undecided */
+#ifndef WAITING_BUFFER_SIZE
+#    define WAITING_BUFFER_SIZE 8
+#endif
+
+/* maximum time(ms) key events are held back while the waiting buffer is full */
+#ifndef WAITING_BUFFER_BACK_PRESSURE_TIMEOUT
+#    define WAITING_BUFFER_BACK_PRESSURE_TIMEOUT 1000
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
 uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache);
 void     action_tapping_process(keyrecord_t record);
+#    ifdef WAITING_BUFFER_BACK_PRESSURE
+bool action_tapping_ready(keyevent_t event);
+#    endif
 #endif
 
 uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
@@ -50,6 +61,31 @@ bool     get_hold_on_other_key_press(uint16_t keycode, keyrecord_t *record);
 extern uint16_t g_tapping_term;
 #endif
 
+#ifdef TAP_HOLD_TABLE
+/* tap-hold settings of a keycode, taking precedence over the global and per key configuration */
+typedef struct {
+    uint16_t keycode;
+    uint16_t tapping_term;
+    uint16_t quick_tap_term;
+    uint8_t  flags;
+} tap_hold_table_entry_t;
+
+#    define TAP_HOLD_PERMISSIVE_HOLD (1 << 0)
+#    define TAP_HOLD_HOLD_ON_OTHER_KEY_PRESS (1 << 1)
+
+/* flags of the global configuration, for entries that leave them unspecified */
+#    ifdef PERMISSIVE_HOLD
+#        define TAP_HOLD_DEFAULT_PERMISSIVE_HOLD TAP_HOLD_PERMISSIVE_HOLD
+#    else
+#        define TAP_HOLD_DEFAULT_PERMISSIVE_HOLD 0
+#    endif
+#    ifdef HOLD_ON_OTHER_KEY_PRESS
+#        define TAP_HOLD_DEFAULT_HOLD_ON_OTHER_KEY_PRESS TAP_HOLD_HOLD_ON_OTHER_KEY_PRESS
+#    else
+#        define TAP_HOLD_DEFAULT_HOLD_ON_OTHER_KEY_PRESS 0
+#    endif
+#endif
+
 #if defined(TAPPING_TERM_PER_KEY) && !defined(NO_ACTION_TAPPING)
 #    define GET_TAPPING_TERM(keycode, record) get_tapping_term(keycode, record)
 #elif defined(DYNAMIC_TAPPING_TERM_ENABLE) && !defined(NO_ACTION_TAPPING)
@@ -22,6 +22,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "timer.h"
 #include "keycode_config.h"
 #include "usb_device_state.h"
+#include "profiler.h"
+#include "wait.h"
 #include <string.h>
 
 extern keymap_config_t keymap_config;
@@ -283,33 +285,207 @@ static uint8_t get_mods_for_report(void) {
     return mods;
 }
 
+#if defined(KEYBOARD_REPORT_COALESCING) && !defined(PROTOCOL_VUSB)
+// Last report handed to the host, and the report merging the changes made since
+static report_keyboard_t keyboard_report_sent;
+static report_keyboard_t keyboard_report_staged;
+// Report that has to reach the host before the staged one, because the staged one reverted it while the endpoint was busy
+static report_keyboard_t keyboard_report_queued;
+static bool              keyboard_report_queued_pending = false;
+
+// Time at which the staged report started to differ from the sent one
+static uint16_t keyboard_report_staged_time;
+// Whether the staged report was already held back by a busy endpoint in an earlier main loop iteration
+static bool keyboard_report_staged_deferred = false;
+
+/** \brief Starts staging a change, if the staged report does not differ from the sent one yet
+ */
+static void keyboard_report_stage_started(bool staged_is_sent) {
+    if (staged_is_sent) {
+        keyboard_report_staged_time     = timer_read();
+        keyboard_report_staged_deferred = false;
+    }
+}
+
+/** \brief Keeps a staged change that is about to be reverted on the host for as long as it has been staged
+ *
+ * Callers such as tap_code16_delay() wait between a change and its revert. The change only reaches the host once it
+ * is reverted, so the wait has to be repeated for the host to see it. A change that has been held back by a busy
+ * endpoint was not delayed by its caller, so it is not held, as that could stall the main loop for as long as the
+ * host stopped polling.
+ */
+static void hold_reverted_report(void) {
+    if (!keyboard_report_staged_deferred) {
+        wait_ms(timer_elapsed(keyboard_report_staged_time));
+    }
+}
+
+static bool report_keyboard_has_key(const report_keyboard_t *report, uint8_t key) {
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (report->keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** \brief Checks whether a report undoes a staged change, which the host would never see if both were merged
+ */
+static bool keyboard_report_reverts_staged(const report_keyboard_t *report) {
+    if ((keyboard_report_sent.mods ^ keyboard_report_staged.mods) & (keyboard_report_staged.mods ^ report->mods)) {
+        return true;
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t key = keyboard_report_staged.keys[i];
+        if (key != KC_NO && !report_keyboard_has_key(&keyboard_report_sent, key) && !report_keyboard_has_key(report, key)) {
+            return true;
+        }
+        key = keyboard_report_sent.keys[i];
+        if (key != KC_NO && !report_keyboard_has_key(&keyboard_report_staged, key) && report_keyboard_has_key(report, key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** \brief Hands the queued report and then the staged report to the host, waiting for the endpoint if needed
+ */
+static void flush_6kro_report(void) {
+    if (keyboard_report_queued_pending) {
+        keyboard_report_queued_pending = false;
+        PROFILER_PROBE(HOST_KEYBOARD_SEND, host_keyboard_send(&keyboard_report_queued));
+    }
+    if (memcmp(&keyboard_report_staged, &keyboard_report_sent, sizeof(report_keyboard_t)) != 0) {
+        memcpy(&keyboard_report_sent, &keyboard_report_staged, sizeof(report_keyboard_t));
+        PROFILER_PROBE(HOST_KEYBOARD_SEND, host_keyboard_send(&keyboard_report_sent));
+    }
+}
+
+/** \brief Hands one report to the host, once the endpoint is known to have room for it
+ */
+static void send_6kro_report_when_ready(void) {
+    if (keyboard_report_queued_pending) {
+        keyboard_report_queued_pending = false;
+        PROFILER_PROBE(HOST_KEYBOARD_SEND, host_keyboard_send(&keyboard_report_queued));
+    } else {
+        flush_6kro_report();
+    }
+}
+
+/** \brief Sends the staged change before the report reverting it is staged
+ *
+ * While the endpoint is busy, the staged report is queued to be sent first instead. Only when a report is already
+ * queued, and the host has fallen that far behind, is the endpoint waited for.
+ */
+static void commit_6kro_report(void) {
+    if (host_keyboard_ready()) {
+        flush_6kro_report();
+        hold_reverted_report();
+    } else if (!keyboard_report_queued_pending) {
+        memcpy(&keyboard_report_queued, &keyboard_report_staged, sizeof(report_keyboard_t));
+        memcpy(&keyboard_report_sent, &keyboard_report_staged, sizeof(report_keyboard_t));
+        keyboard_report_queued_pending = true;
+    } else {
+        flush_6kro_report();
+    }
+}
+#endif
+
 void send_6kro_report(void) {
     keyboard_report->mods = get_mods_for_report();
 
 #ifdef PROTOCOL_VUSB
-    host_keyboard_send(keyboard_report);
+    PROFILER_PROBE(HOST_KEYBOARD_SEND, host_keyboard_send(keyboard_report));
+#elif defined(KEYBOARD_REPORT_COALESCING)
+    if (keyboard_report_reverts_staged(keyboard_report)) {
+        commit_6kro_report();
+    }
+    keyboard_report_stage_started(memcmp(&keyboard_report_staged, &keyboard_report_sent, sizeof(report_keyboard_t)) == 0);
+    memcpy(&keyboard_report_staged, keyboard_report, sizeof(report_keyboard_t));
 #else
     static report_keyboard_t last_report;
 
     /* Only send the report if there are changes to propagate to the host. */
     if (memcmp(keyboard_report, &last_report, sizeof(report_keyboard_t)) != 0) {
         memcpy(&last_report, keyboard_report, sizeof(report_keyboard_t));
-        host_keyboard_send(keyboard_report);
+        PROFILER_PROBE(HOST_KEYBOARD_SEND, host_keyboard_send(keyboard_report));
     }
 #endif
 }
 
 #ifdef NKRO_ENABLE
+#    ifdef KEYBOARD_REPORT_COALESCING
+static report_nkro_t nkro_report_sent;
+static report_nkro_t nkro_report_staged;
+static report_nkro_t nkro_report_queued;
+static bool          nkro_report_queued_pending = false;
+
+/** \brief Checks whether a report undoes a staged change, which the host would never see if both were merged
+ */
+static bool nkro_report_reverts_staged(const report_nkro_t *report) {
+    if ((nkro_report_sent.mods ^ nkro_report_staged.mods) & (nkro_report_staged.mods ^ report->mods)) {
+        return true;
+    }
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        if ((nkro_report_sent.bits[i] ^ nkro_report_staged.bits[i]) & (nkro_report_staged.bits[i] ^ report->bits[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void flush_nkro_report(void) {
+    if (nkro_report_queued_pending) {
+        nkro_report_queued_pending = false;
+        PROFILER_PROBE(HOST_KEYBOARD_SEND, host_nkro_send(&nkro_report_queued));
+    }
+    if (memcmp(&nkro_report_staged, &nkro_report_sent, sizeof(report_nkro_t)) != 0) {
+        memcpy(&nkro_report_sent, &nkro_report_staged, sizeof(report_nkro_t));
+        PROFILER_PROBE(HOST_KEYBOARD_SEND, host_nkro_send(&nkro_report_sent));
+    }
+}
+
+static void send_nkro_report_when_ready(void) {
+    if (nkro_report_queued_pending) {
+        nkro_report_queued_pending = false;
+        PROFILER_PROBE(HOST_KEYBOARD_SEND, host_nkro_send(&nkro_report_queued));
+    } else {
+        flush_nkro_report();
+    }
+}
+
+static void commit_nkro_report(void) {
+    if (host_keyboard_ready()) {
+        flush_nkro_report();
+        hold_reverted_report();
+    } else if (!nkro_report_queued_pending) {
+        memcpy(&nkro_report_queued, &nkro_report_staged, sizeof(report_nkro_t));
+        memcpy(&nkro_report_sent, &nkro_report_staged, sizeof(report_nkro_t));
+        nkro_report_queued_pending = true;
+    } else {
+        flush_nkro_report();
+    }
+}
+#    endif
+
 void send_nkro_report(void) {
     nkro_report->mods = get_mods_for_report();
 
+#    ifdef KEYBOARD_REPORT_COALESCING
+    if (nkro_report_reverts_staged(nkro_report)) {
+        commit_nkro_report();
+    }
+    keyboard_report_stage_started(memcmp(&nkro_report_staged, &nkro_report_sent, sizeof(report_nkro_t)) == 0);
+    memcpy(&nkro_report_staged, nkro_report, sizeof(report_nkro_t));
+#    else
     static report_nkro_t last_report;
 
     /* Only send the report if there are changes to propagate to the host. */
     if (memcmp(nkro_report, &last_report, sizeof(report_nkro_t)) != 0) {
         memcpy(&last_report, nkro_report, sizeof(report_nkro_t));
-        host_nkro_send(nkro_report);
+        PROFILER_PROBE(HOST_KEYBOARD_SEND, host_nkro_send(nkro_report));
     }
+#    endif
 }
 #endif
 
@@ -329,6 +505,34 @@ void send_keyboard_report(void) {
 #endif
 }
 
+#if defined(KEYBOARD_REPORT_COALESCING) && !defined(PROTOCOL_VUSB)
+/** \brief Flush keyboard report
+ *
+ * Hands the queued and staged keyboard reports to the host, if they differ from the last one sent.
+ */
+void flush_keyboard_report(void) {
+    flush_6kro_report();
+#    ifdef NKRO_ENABLE
+    flush_nkro_report();
+#    endif
+}
+
+/** \brief Keyboard report task
+ *
+ * Hands the next keyboard report to the host once per main loop iteration, if the endpoint has room for it.
+ */
+void keyboard_report_task(void) {
+    if (host_keyboard_ready()) {
+        send_6kro_report_when_ready();
+#    ifdef NKRO_ENABLE
+        send_nkro_report_when_ready();
+#    endif
+    }
+    // Any change still staged from now on is waiting for the host rather than for its caller
+    keyboard_report_staged_deferred = true;
+}
+#endif
+
 /** \brief Get mods
  *
  * FIXME: needs doc
@@ -32,6 +32,14 @@ extern report_nkro_t *nkro_report;
 
 void send_keyboard_report(void);
 
+#if defined(KEYBOARD_REPORT_COALESCING) && !defined(PROTOCOL_VUSB)
+void flush_keyboard_report(void);
+void keyboard_report_task(void);
+#else
+static inline void flush_keyboard_report(void) {}
+static inline void keyboard_report_task(void) {}
+#endif
+
 /* key */
 inline void add_key(uint8_t key) {
     add_key_to_report(key);
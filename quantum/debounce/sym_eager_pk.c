@@ -43,8 +43,17 @@ No further inputs are accepted until DEBOUNCE milliseconds have occurred.
 
 typedef uint8_t debounce_counter_t;
 
+// Index of a key's counter, row * MATRIX_COLS + col
+#if (MATRIX_ROWS * MATRIX_COLS) > UINT8_MAX
+typedef uint16_t debounce_index_t;
+#else
+typedef uint8_t debounce_index_t;
+#endif
+
 #if DEBOUNCE > 0
 static debounce_counter_t *debounce_counters;
+static debounce_index_t   *active_keys;
+static debounce_index_t    active_key_count;
 static fast_timer_t        last_time;
 static bool                counters_need_update;
 static bool                matrix_need_update;
@@ -52,7 +61,7 @@ static bool                cooked_changed;
 
 #    define DEBOUNCE_ELAPSED 0
 
-static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time);
+static void update_debounce_counters(uint8_t elapsed_time);
 static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
 
 // we use num_rows rather than MATRIX_ROWS to support split keyboards
@@ -64,11 +73,15 @@ void debounce_init(uint8_t num_rows) {
             debounce_counters[i++] = DEBOUNCE_ELAPSED;
         }
     }
+    active_keys      = (debounce_index_t *)malloc(num_rows * MATRIX_COLS * sizeof(debounce_index_t));
+    active_key_count = 0;
 }
 
 void debounce_free(void) {
     free(debounce_counters);
     debounce_counters = NULL;
+    free(active_keys);
+    active_keys = NULL;
 }
 
 bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
@@ -86,7 +99,7 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
         }
 
         if (elapsed_time > 0) {
-            update_debounce_counters(num_rows, elapsed_time);
+            update_debounce_counters(elapsed_time);
         }
     }
 
@@ -102,44 +115,42 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
 }
 
 // If the current time is > debounce counter, set the counter to enable input.
-static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time) {
-    counters_need_update                 = false;
-    matrix_need_update                   = false;
-    debounce_counter_t *debounce_pointer = debounce_counters;
-    for (uint8_t row = 0; row < num_rows; row++) {
-        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
-            if (*debounce_pointer != DEBOUNCE_ELAPSED) {
-                if (*debounce_pointer <= elapsed_time) {
-                    *debounce_pointer  = DEBOUNCE_ELAPSED;
-                    matrix_need_update = true;
-                } else {
-                    *debounce_pointer -= elapsed_time;
-                    counters_need_update = true;
-                }
-            }
-            debounce_pointer++;
+// Only the keys with a running counter are visited, so the cost is proportional to the number of bouncing keys.
+static void update_debounce_counters(uint8_t elapsed_time) {
+    matrix_need_update = false;
+    for (debounce_index_t i = 0; i < active_key_count;) {
+        debounce_counter_t *debounce_pointer = &debounce_counters[active_keys[i]];
+        if (*debounce_pointer <= elapsed_time) {
+            *debounce_pointer  = DEBOUNCE_ELAPSED;
+            matrix_need_update = true;
+            // Remove from the active list by moving the last entry into its place
+            active_keys[i] = active_keys[--active_key_count];
+        } else {
+            *debounce_pointer -= elapsed_time;
+            i++;
         }
     }
+    counters_need_update = active_key_count > 0;
 }
 
 // upload from raw_matrix to final matrix;
 static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
-    matrix_need_update                   = false;
-    debounce_counter_t *debounce_pointer = debounce_counters;
+    matrix_need_update = false;
     for (uint8_t row = 0; row < num_rows; row++) {
-        matrix_row_t delta        = raw[row] ^ cooked[row];
-        matrix_row_t existing_row = cooked[row];
-        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
-            matrix_row_t col_mask = (ROW_SHIFTER << col);
-            if (delta & col_mask) {
-                if (*debounce_pointer == DEBOUNCE_ELAPSED) {
-                    *debounce_pointer    = DEBOUNCE;
-                    counters_need_update = true;
-                    existing_row ^= col_mask; // flip the bit.
-                    cooked_changed = true;
-                }
+        matrix_row_t delta = raw[row] ^ cooked[row];
+        if (!delta) {
+            continue;
+        }
+        matrix_row_t     existing_row = cooked[row];
+        debounce_index_t index        = row * MATRIX_COLS;
+        for (uint8_t col = 0; delta; col++, index++, delta >>= 1) {
+            if ((delta & 1) && debounce_counters[index] == DEBOUNCE_ELAPSED) {
+                debounce_counters[index]        = DEBOUNCE;
+                active_keys[active_key_count++] = index;
+                counters_need_update            = true;
+                existing_row ^= (ROW_SHIFTER << col); // flip the bit.
+                cooked_changed = true;
             }
-            debounce_pointer++;
         }
         cooked[row] = existing_row;
     }
@@ -43,6 +43,11 @@ debounce_sym_eager_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_eager_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/sym_eager_pk_tests.cpp
 
+debounce_sym_eager_pk_vertical_DEFS := $(DEBOUNCE_COMMON_DEFS)
+debounce_sym_eager_pk_vertical_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_eager_pk_vertical.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_eager_pk_tests.cpp
+
 debounce_sym_eager_pr_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_sym_eager_pr_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/sym_eager_pr.c \
@@ -17,10 +17,13 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "timer.h"
+#include "util.h"
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -97,6 +100,90 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + 1)
 #endif
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// Keymaps, encoder maps and macros are mirrored as one contiguous block
+#    define DYNAMIC_KEYMAP_MIRROR_SIZE ((DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + (DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) - (DYNAMIC_KEYMAP_EEPROM_ADDR))
+_Static_assert((DYNAMIC_KEYMAP_EEPROM_ADDR) <= (DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) && (DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) <= (DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR), "DYNAMIC_KEYMAP_RAM_MIRROR requires keymaps, encoder maps and macros to be stored in that order.");
+
+// Writes are tracked per chunk, and written back a chunk at a time
+#    ifndef DYNAMIC_KEYMAP_MIRROR_CHUNK_SIZE
+#        define DYNAMIC_KEYMAP_MIRROR_CHUNK_SIZE 32
+#    endif
+#    define DYNAMIC_KEYMAP_MIRROR_CHUNK_COUNT (((DYNAMIC_KEYMAP_MIRROR_SIZE) + (DYNAMIC_KEYMAP_MIRROR_CHUNK_SIZE)-1) / (DYNAMIC_KEYMAP_MIRROR_CHUNK_SIZE))
+
+// Milliseconds without further writes before pending changes are written back to EEPROM
+#    ifndef DYNAMIC_KEYMAP_FLUSH_DELAY
+#        define DYNAMIC_KEYMAP_FLUSH_DELAY 1000
+#    endif
+
+static uint8_t  dynamic_keymap_mirror[DYNAMIC_KEYMAP_MIRROR_SIZE];
+static uint8_t  dynamic_keymap_mirror_dirty[((DYNAMIC_KEYMAP_MIRROR_CHUNK_COUNT) + 7) / 8] = {0};
+static bool     dynamic_keymap_mirror_loaded                                              = false;
+static bool     dynamic_keymap_mirror_pending                                             = false;
+static uint16_t dynamic_keymap_mirror_last_write                                          = 0;
+
+static uint8_t *dynamic_keymap_mirror_address(const void *address) {
+    uintptr_t offset = (uintptr_t)address - (uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR);
+    if (offset >= DYNAMIC_KEYMAP_MIRROR_SIZE) {
+        return NULL;
+    }
+    if (!dynamic_keymap_mirror_loaded) {
+        eeprom_read_block(dynamic_keymap_mirror, (const void *)(DYNAMIC_KEYMAP_EEPROM_ADDR), DYNAMIC_KEYMAP_MIRROR_SIZE);
+        dynamic_keymap_mirror_loaded = true;
+    }
+    return &dynamic_keymap_mirror[offset];
+}
+
+static uint8_t dynamic_keymap_read_byte(const void *address) {
+    uint8_t *mirror = dynamic_keymap_mirror_address(address);
+    return mirror ? *mirror : eeprom_read_byte(address);
+}
+
+static void dynamic_keymap_update_byte(void *address, uint8_t value) {
+    uint8_t *mirror = dynamic_keymap_mirror_address(address);
+    if (!mirror) {
+        eeprom_update_byte(address, value);
+        return;
+    }
+
+    // Always mark the chunk, as the EEPROM may have been reformatted underneath the mirror
+    uint16_t chunk = (mirror - dynamic_keymap_mirror) / (DYNAMIC_KEYMAP_MIRROR_CHUNK_SIZE);
+    dynamic_keymap_mirror_dirty[chunk / 8] |= (1 << (chunk % 8));
+
+    *mirror                          = value;
+    dynamic_keymap_mirror_pending    = true;
+    dynamic_keymap_mirror_last_write = timer_read();
+}
+
+void dynamic_keymap_flush(void) {
+    if (!dynamic_keymap_mirror_pending) {
+        return;
+    }
+
+    for (uint16_t chunk = 0; chunk < DYNAMIC_KEYMAP_MIRROR_CHUNK_COUNT; chunk++) {
+        if (!(dynamic_keymap_mirror_dirty[chunk / 8] & (1 << (chunk % 8)))) {
+            continue;
+        }
+
+        // Chunks that haven't been written to are neither compared against nor written back to the EEPROM
+        uint16_t offset = chunk * (DYNAMIC_KEYMAP_MIRROR_CHUNK_SIZE);
+        uint16_t size   = MIN(DYNAMIC_KEYMAP_MIRROR_CHUNK_SIZE, DYNAMIC_KEYMAP_MIRROR_SIZE - offset);
+        eeprom_update_block(&dynamic_keymap_mirror[offset], (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), size);
+        dynamic_keymap_mirror_dirty[chunk / 8] &= ~(1 << (chunk % 8));
+    }
+    dynamic_keymap_mirror_pending = false;
+}
+
+void dynamic_keymap_task(void) {
+    if (dynamic_keymap_mirror_pending && timer_elapsed(dynamic_keymap_mirror_last_write) >= DYNAMIC_KEYMAP_FLUSH_DELAY) {
+        dynamic_keymap_flush();
+    }
+}
+#else
+#    define dynamic_keymap_read_byte(address) eeprom_read_byte(address)
+#    define dynamic_keymap_update_byte(address, value) eeprom_update_byte(address, value)
+#endif
+
 #ifndef DYNAMIC_KEYMAP_MACRO_DELAY
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
@@ -114,8 +201,8 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
+    uint16_t keycode = dynamic_keymap_read_byte(address) << 8;
+    keycode |= dynamic_keymap_read_byte(address + 1);
     return keycode;
 }
 
@@ -123,8 +210,10 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address, (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    keypos_t key = {.row = row, .col = column};
+    effective_keymap_cache_clear_key(key);
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -136,8 +225,8 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
-    keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
+    uint16_t keycode = ((uint16_t)dynamic_keymap_read_byte(address + (clockwise ? 0 : 2))) << 8;
+    keycode |= dynamic_keymap_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
 }
 
@@ -145,8 +234,8 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -173,7 +262,7 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
+            *target = dynamic_keymap_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -188,11 +277,12 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint8_t *source                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
+            dynamic_keymap_update_byte(target, *source);
         }
         source++;
         target++;
     }
+    effective_keymap_cache_clear();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -224,7 +314,7 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
+            *target = dynamic_keymap_read_byte(source);
         } else {
             *target = 0x00;
         }
@@ -238,7 +328,7 @@ void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *da
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
+            dynamic_keymap_update_byte(target, *source);
         }
         source++;
         target++;
@@ -249,7 +339,7 @@ void dynamic_keymap_macro_reset(void) {
     void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
     void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
     while (p != end) {
-        eeprom_update_byte(p, 0);
+        dynamic_keymap_update_byte(p, 0);
         ++p;
     }
 }
@@ -264,7 +354,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
     // of buffer writing, possibly an aborted buffer
     // write. So do nothing.
     void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
+    if (dynamic_keymap_read_byte(p) != 0) {
         return;
     }
 
@@ -278,7 +368,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
         if (p == end) {
             return;
         }
-        if (eeprom_read_byte(p) == 0) {
+        if (dynamic_keymap_read_byte(p) == 0) {
             --id;
         }
         ++p;
@@ -289,7 +379,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
     // We already checked there was a null at the end of
     // the buffer, so this cannot go past the end
     while (1) {
-        data[0] = eeprom_read_byte(p++);
+        data[0] = dynamic_keymap_read_byte(p++);
         data[1] = 0;
         // Stop at the null terminator of this macro string
         if (data[0] == 0) {
@@ -297,14 +387,14 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         if (data[0] == SS_QMK_PREFIX) {
             // Get the code
-            data[1] = eeprom_read_byte(p++);
+            data[1] = dynamic_keymap_read_byte(p++);
             // Unexpected null, abort.
             if (data[1] == 0) {
                 return;
             }
             if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
                 // Get the keycode
-                data[2] = eeprom_read_byte(p++);
+                data[2] = dynamic_keymap_read_byte(p++);
                 // Unexpected null, abort.
                 if (data[2] == 0) {
                     return;
@@ -316,7 +406,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
                 // At most this is 4 digits plus '|'
                 uint8_t i = 2;
                 while (1) {
-                    data[i] = eeprom_read_byte(p++);
+                    data[i] = dynamic_keymap_read_byte(p++);
                     // Unexpected null, abort
                     if (data[i] == 0) {
                         return;
@@ -68,3 +68,11 @@ void     dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t
 void     dynamic_keymap_macro_reset(void);
 
 void dynamic_keymap_macro_send(uint8_t id);
+
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// With DYNAMIC_KEYMAP_RAM_MIRROR, reads are served from a copy of the keymaps, encoder maps and macros in RAM,
+// and writes are collected there and written back to EEPROM once no further writes have happened for
+// DYNAMIC_KEYMAP_FLUSH_DELAY milliseconds. dynamic_keymap_flush() writes back pending changes immediately.
+void dynamic_keymap_flush(void);
+void dynamic_keymap_task(void);
+#endif
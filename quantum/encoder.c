@@ -18,13 +18,12 @@ static encoder_events_t encoder_events;
 static bool             signal_queue_drain = false;
 
 void encoder_init(void) {
-    memset(&encoder_events, 0, sizeof(encoder_events));
+    encoder_event_queue_init(&encoder_events);
     encoder_driver_init();
 }
 
 static void encoder_queue_drain(void) {
-    encoder_events.tail     = encoder_events.head;
-    encoder_events.dequeued = encoder_events.enqueued;
+    encoder_event_queue_clear(&encoder_events);
 }
 
 static bool encoder_handle_queue(void) {
@@ -83,7 +82,7 @@ bool encoder_task(void) {
 }
 
 bool encoder_queue_full_advanced(encoder_events_t *events) {
-    return events->tail == (events->head + 1) % MAX_QUEUED_ENCODER_EVENTS;
+    return encoder_event_queue_full(events);
 }
 
 bool encoder_queue_full(void) {
@@ -91,7 +90,7 @@ bool encoder_queue_full(void) {
 }
 
 bool encoder_queue_empty_advanced(encoder_events_t *events) {
-    return events->head == events->tail;
+    return encoder_event_queue_empty(events);
 }
 
 bool encoder_queue_empty(void) {
@@ -99,35 +98,19 @@ bool encoder_queue_empty(void) {
 }
 
 bool encoder_queue_event_advanced(encoder_events_t *events, uint8_t index, bool clockwise) {
-    // Drop out if we're full
-    if (encoder_queue_full_advanced(events)) {
-        return false;
-    }
-
-    // Append the event
-    encoder_event_t new_event   = {.index = index, .clockwise = clockwise ? 1 : 0};
-    events->queue[events->head] = new_event;
-
-    // Increment the head index
-    events->head = (events->head + 1) % MAX_QUEUED_ENCODER_EVENTS;
-    events->enqueued++;
-
-    return true;
+    // Append the event, the new one is dropped if we're full
+    encoder_event_t new_event = {.index = index, .clockwise = clockwise ? 1 : 0};
+    return encoder_event_queue_push(events, new_event);
 }
 
 bool encoder_dequeue_event_advanced(encoder_events_t *events, uint8_t *index, bool *clockwise) {
-    if (encoder_queue_empty_advanced(events)) {
+    // Retrieve the event
+    encoder_event_t event;
+    if (!encoder_event_queue_pop(events, &event)) {
         return false;
     }
-
-    // Retrieve the event
-    encoder_event_t event = events->queue[events->tail];
-    *index                = event.index;
-    *clockwise            = event.clockwise;
-
-    // Increment the tail index
-    events->tail = (events->tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
-    events->dequeued++;
+    *index     = event.index;
+    *clockwise = event.clockwise;
 
     return true;
 }
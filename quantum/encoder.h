@@ -21,6 +21,7 @@
 #include <stdbool.h>
 #include "gpio.h"
 #include "util.h"
+#include "spsc_queue.h"
 
 // ======== DEPRECATED DEFINES - DO NOT USE ========
 #ifdef ENCODERS_PAD_A
@@ -82,8 +83,9 @@ bool encoder_update_user(uint8_t index, bool clockwise);
 
 #    define NUM_ENCODERS_MAX_PER_SIDE MAX(NUM_ENCODERS_LEFT, NUM_ENCODERS_RIGHT)
 
+// Must be a power of two, see spsc_queue.h
 #    ifndef MAX_QUEUED_ENCODER_EVENTS
-#        define MAX_QUEUED_ENCODER_EVENTS MAX(4, ((NUM_ENCODERS_MAX_PER_SIDE) + 1))
+#        define MAX_QUEUED_ENCODER_EVENTS SPSC_QUEUE_SIZE_FOR(NUM_ENCODERS_MAX_PER_SIDE)
 #    endif // MAX_QUEUED_ENCODER_EVENTS
 
 typedef struct encoder_event_t {
@@ -91,13 +93,10 @@ typedef struct encoder_event_t {
     uint8_t clockwise : 1;
 } encoder_event_t;
 
-typedef struct encoder_events_t {
-    uint8_t         enqueued;
-    uint8_t         dequeued;
-    uint8_t         head;
-    uint8_t         tail;
-    encoder_event_t queue[MAX_QUEUED_ENCODER_EVENTS];
-} encoder_events_t;
+// Events are queued from the encoder driver, which may run in interrupt context
+SPSC_QUEUE_DECLARE(encoder_event_queue, encoder_event_t, MAX_QUEUED_ENCODER_EVENTS)
+
+typedef encoder_event_queue_t encoder_events_t;
 
 // Get the current queued events
 void encoder_retrieve_events(encoder_events_t *events);
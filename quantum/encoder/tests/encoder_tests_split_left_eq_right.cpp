@@ -117,7 +117,7 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseLeftMaster) {
     encoder_events_t events;
     encoder_retrieve_events(&events);
     while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events.tail++;
         ++events_queued;
     }
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
@@ -141,7 +141,7 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseRightMaster) {
     encoder_events_t events;
     encoder_retrieve_events(&events);
     while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events.tail++;
         ++events_queued;
     }
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
@@ -163,7 +163,7 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseLeftSlave) {
     encoder_events_t events;
     encoder_retrieve_events(&events);
     while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events.tail++;
         ++events_queued;
     }
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
@@ -185,7 +185,7 @@ TEST_F(EncoderSplitTestLeftEqRight, TestOneClockwiseRightSlave) {
     encoder_events_t events;
     encoder_retrieve_events(&events);
     while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events.tail++;
         ++events_queued;
     }
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
@@ -119,7 +119,7 @@ TEST_F(EncoderSplitTestLeftLessThanRight, TestOneClockwiseLeftMaster) {
     encoder_events_t events;
     encoder_retrieve_events(&events);
     while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events.tail++;
         ++events_queued;
     }
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
@@ -143,7 +143,7 @@ TEST_F(EncoderSplitTestLeftLessThanRight, TestOneClockwiseRightMaster) {
     encoder_events_t events;
     encoder_retrieve_events(&events);
     while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events.tail++;
         ++events_queued;
     }
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
@@ -165,7 +165,7 @@ TEST_F(EncoderSplitTestLeftLessThanRight, TestOneClockwiseLeftSlave) {
     encoder_events_t events;
     encoder_retrieve_events(&events);
     while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events.tail++;
         ++events_queued;
     }
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
@@ -187,7 +187,7 @@ TEST_F(EncoderSplitTestLeftLessThanRight, TestOneClockwiseRightSlave) {
     encoder_events_t events;
     encoder_retrieve_events(&events);
     while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events.tail++;
         ++events_queued;
     }
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
@@ -107,7 +107,7 @@ TEST_F(EncoderSplitTestNoLeft, TestOneClockwiseLeftMaster) {
     encoder_events_t events;
     encoder_retrieve_events(&events);
     while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events.tail++;
         ++events_queued;
     }
     EXPECT_EQ(events_queued, 0); // No events should be queued on master
@@ -129,7 +129,7 @@ TEST_F(EncoderSplitTestNoLeft, TestOneClockwiseRightSlave) {
     encoder_events_t events;
     encoder_retrieve_events(&events);
     while (events.tail != events.head) {
-        events.tail = (events.tail + 1) % MAX_QUEUED_ENCODER_EVENTS;
+        events.tail++;
         ++events_queued;
     }
     EXPECT_EQ(events_queued, 1); // One event should be queued on slave
@@ -32,6 +32,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "action_tapping.h"
+#include "action_util.h"
+#include "profiler.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -143,6 +146,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef LAYER_LOCK_ENABLE
 #    include "layer_lock.h"
 #endif
+#ifdef TASK_SCHEDULER_ENABLE
+#    include "task_scheduler.h"
+#endif
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 
 static uint32_t last_input_modification_time = 0;
 uint32_t        last_input_activity_time(void) {
@@ -404,6 +416,47 @@ void quantum_init(void) {
     layer_state_set_kb((layer_state_t)layer_state);
 }
 
+#ifdef TASK_SCHEDULER_ENABLE
+/** \brief keyboard_scheduler_init
+ *
+ * Registers the non-critical core tasks with the task scheduler, so that they run after matrix scanning and report
+ * generation, and within a bounded time budget per main loop iteration.
+ */
+static void keyboard_scheduler_init(void) {
+#    if defined(RGBLIGHT_ENABLE)
+    task_scheduler_register(rgblight_task, TASK_PRIORITY_LOW, 0, TASK_SCHEDULER_LOW_PRIORITY_DEADLINE);
+#    endif
+#    ifdef LED_MATRIX_ENABLE
+    task_scheduler_register(led_matrix_task, TASK_PRIORITY_LOW, 0, TASK_SCHEDULER_LOW_PRIORITY_DEADLINE);
+#    endif
+#    ifdef RGB_MATRIX_ENABLE
+    task_scheduler_register(rgb_matrix_task, TASK_PRIORITY_LOW, 0, TASK_SCHEDULER_LOW_PRIORITY_DEADLINE);
+#    endif
+#    if defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))
+    task_scheduler_register(backlight_task, TASK_PRIORITY_LOW, 0, TASK_SCHEDULER_LOW_PRIORITY_DEADLINE);
+#    endif
+#    ifdef OLED_ENABLE
+    task_scheduler_register(oled_task, TASK_PRIORITY_LOW, 0, TASK_SCHEDULER_LOW_PRIORITY_DEADLINE);
+#    endif
+#    ifdef ST7565_ENABLE
+    task_scheduler_register(st7565_task, TASK_PRIORITY_LOW, 0, TASK_SCHEDULER_LOW_PRIORITY_DEADLINE);
+#    endif
+#    ifdef HAPTIC_ENABLE
+    task_scheduler_register(haptic_task, TASK_PRIORITY_NORMAL, 0, TASK_SCHEDULER_NORMAL_PRIORITY_DEADLINE);
+#    endif
+    task_scheduler_register(led_task, TASK_PRIORITY_NORMAL, 0, TASK_SCHEDULER_NORMAL_PRIORITY_DEADLINE);
+#    ifdef OS_DETECTION_ENABLE
+    task_scheduler_register(os_detection_task, TASK_PRIORITY_NORMAL, 0, TASK_SCHEDULER_NORMAL_PRIORITY_DEADLINE);
+#    endif
+#    if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    task_scheduler_register(dynamic_keymap_task, TASK_PRIORITY_LOW, 0, TASK_SCHEDULER_LOW_PRIORITY_DEADLINE);
+#    endif
+#    if defined(PROFILER_ENABLE) && PROFILER_CONSOLE_INTERVAL > 0
+    task_scheduler_register(profiler_task, TASK_PRIORITY_LOW, 0, TASK_SCHEDULER_LOW_PRIORITY_DEADLINE);
+#    endif
+}
+#endif
+
 /** \brief keyboard_init
  *
  * FIXME: needs doc
@@ -489,6 +542,10 @@ void keyboard_init(void) {
     haptic_init();
 #endif
 
+#ifdef TASK_SCHEDULER_ENABLE
+    keyboard_scheduler_init();
+#endif
+
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
 #endif
@@ -538,7 +595,7 @@ static bool matrix_task(void) {
 
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
-    matrix_scan();
+    PROFILER_PROBE(MATRIX_SCAN, matrix_scan());
     bool matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
         matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
@@ -557,6 +614,7 @@ static bool matrix_task(void) {
     }
 
     const bool process_keypress = should_process_keypress();
+    bool       held_back        = false;
 
     for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
         const matrix_row_t current_row = matrix_get_row(row);
@@ -572,14 +630,26 @@ static bool matrix_task(void) {
                 const bool key_pressed = current_row & col_mask;
 
                 if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                    const keyevent_t event = MAKE_KEYEVENT(row, col, key_pressed);
+#if defined(WAITING_BUFFER_BACK_PRESSURE) && !defined(NO_ACTION_TAPPING)
+                    // Leave this and all following changes unprocessed, they are retried on the next scan
+                    held_back = held_back || !action_tapping_ready(event);
+                    if (held_back) {
+                        continue;
+                    }
+#endif
+                    action_exec(event);
                 }
 
                 switch_events(row, col, key_pressed);
+                matrix_previous[row] ^= col_mask;
             }
         }
+    }
 
-        matrix_previous[row] = current_row;
+    // Held back changes keep the matrix from settling, the tapping state still has to time out
+    if (held_back) {
+        generate_tick_event();
     }
 
     return matrix_changed;
@@ -678,18 +748,18 @@ void keyboard_task(void) {
     split_watchdog_task();
 #endif
 
-#if defined(RGBLIGHT_ENABLE)
+#if defined(RGBLIGHT_ENABLE) && !defined(TASK_SCHEDULER_ENABLE)
     rgblight_task();
 #endif
 
-#ifdef LED_MATRIX_ENABLE
+#if defined(LED_MATRIX_ENABLE) && !defined(TASK_SCHEDULER_ENABLE)
     led_matrix_task();
 #endif
-#ifdef RGB_MATRIX_ENABLE
+#if defined(RGB_MATRIX_ENABLE) && !defined(TASK_SCHEDULER_ENABLE)
     rgb_matrix_task();
 #endif
 
-#if defined(BACKLIGHT_ENABLE)
+#if defined(BACKLIGHT_ENABLE) && !defined(TASK_SCHEDULER_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
     backlight_task();
 #    endif
@@ -710,7 +780,9 @@ void keyboard_task(void) {
 #endif
 
 #ifdef OLED_ENABLE
+#    ifndef TASK_SCHEDULER_ENABLE
     oled_task();
+#    endif
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -718,7 +790,9 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ST7565_ENABLE
+#    ifndef TASK_SCHEDULER_ENABLE
     st7565_task();
+#    endif
 #    if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
@@ -746,13 +820,36 @@ void keyboard_task(void) {
     bluetooth_task();
 #endif
 
-#ifdef HAPTIC_ENABLE
-    haptic_task();
+#ifdef KEYBOARD_REPORT_COALESCING
+    // All key changes of this iteration go out as one report, once the endpoint has room for it
+    keyboard_report_task();
 #endif
 
+#ifdef TASK_SCHEDULER_ENABLE
+    // Cosmetic and housekeeping work runs last, time-boxed and in priority order
+    task_scheduler_task();
+#else
+#    ifdef HAPTIC_ENABLE
+    haptic_task();
+#    endif
+
     led_task();
 
-#ifdef OS_DETECTION_ENABLE
+#    ifdef OS_DETECTION_ENABLE
     os_detection_task();
+#    endif
+
+#    if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    dynamic_keymap_task();
+#    endif
+
+#    if defined(PROFILER_ENABLE) && PROFILER_CONSOLE_INTERVAL > 0
+    profiler_task();
+#    endif
+#endif
+
+#ifdef I2C_ASYNC_ENABLE
+    // Callbacks of the completed I2C transfers, such as those queued by the LED flushes above
+    i2c_async_task();
 #endif
 }
@@ -104,6 +104,26 @@ __attribute__((weak)) uint16_t combo_count(void) {
 
 _Static_assert(ARRAY_SIZE(key_combos) <= (QK_KB), "Number of combos is abnormally high. Are you using SAFE_RANGE in an enum for combos?");
 
+#    ifdef COMBO_INDEX_SIZE
+_Static_assert(ARRAY_SIZE(key_combos) <= COMBO_INDEX_SIZE, "COMBO_INDEX_SIZE is smaller than the number of combos");
+#    else
+// No combo can have more than MAX_COMBO_LENGTH keys, so the keys of every combo in the keymap always fit
+#        define COMBO_INDEX_SIZE (ARRAY_SIZE(key_combos) * MAX_COMBO_LENGTH)
+#    endif
+
+static combo_index_entry_t combo_index_entries[COMBO_INDEX_SIZE];
+static uint8_t             combo_index_flags[(ARRAY_SIZE(key_combos) + 7) / 8];
+
+combo_index_entry_t* combo_index_entries_raw(uint16_t* capacity) {
+    *capacity = ARRAY_SIZE(combo_index_entries);
+    return combo_index_entries;
+}
+
+uint8_t* combo_index_flags_raw(uint16_t* capacity) {
+    *capacity = ARRAY_SIZE(combo_index_flags) * 8;
+    return combo_index_flags;
+}
+
 combo_t* combo_get_raw(uint16_t combo_idx) {
     if (combo_idx >= combo_count_raw()) {
         return NULL;
@@ -159,6 +179,13 @@ __attribute__((weak)) uint16_t key_override_count(void) {
 
 _Static_assert(ARRAY_SIZE(key_overrides) <= (QK_KB), "Number of key overrides is abnormally high. Are you using SAFE_RANGE in an enum for key overrides?");
 
+static key_override_index_entry_t key_override_index_entries[ARRAY_SIZE(key_overrides)];
+
+key_override_index_entry_t* key_override_index_entries_raw(uint16_t* capacity) {
+    *capacity = ARRAY_SIZE(key_override_index_entries);
+    return key_override_index_entries;
+}
+
 const key_override_t* key_override_get_raw(uint16_t key_override_idx) {
     if (key_override_idx >= key_override_count_raw()) {
         return NULL;
@@ -66,6 +66,15 @@ combo_t* combo_get_raw(uint16_t combo_idx);
 // Get the combo definition, potentially stored dynamically
 combo_t* combo_get(uint16_t combo_idx);
 
+// Forward declaration of combo_index_entry_t so we don't need to deal with header reordering
+struct combo_index_entry_t;
+typedef struct combo_index_entry_t combo_index_entry_t;
+
+// Get the storage for the combo lookup index and its capacity in entries, sized at compile time for the keys of all combos in the user's keymap
+combo_index_entry_t* combo_index_entries_raw(uint16_t* capacity);
+// Get the storage for one bit per combo in the user's keymap, and its capacity in combos
+uint8_t* combo_index_flags_raw(uint16_t* capacity);
+
 #endif // defined(COMBO_ENABLE)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -108,4 +117,11 @@ const key_override_t* key_override_get_raw(uint16_t key_override_idx);
 // Get the key override definitions, potentially stored dynamically
 const key_override_t* key_override_get(uint16_t key_override_idx);
 
+// Forward declaration of key_override_index_entry_t so we don't need to deal with header reordering
+struct key_override_index_entry_t;
+typedef struct key_override_index_entry_t key_override_index_entry_t;
+
+// Get the storage for the key override lookup index and its capacity in entries, sized at compile time for the key overrides in the user's keymap
+key_override_index_entry_t* key_override_index_entries_raw(uint16_t* capacity);
+
 #endif // defined(KEY_OVERRIDE_ENABLE)
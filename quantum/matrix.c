@@ -21,6 +21,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "atomic_util.h"
+#ifdef MATRIX_SCAN_ON_INTERRUPT
+#    include "timer.h"
+#endif
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -51,6 +54,31 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define MATRIX_INPUT_PRESSED_STATE 0
 #endif
 
+#ifdef MATRIX_SCAN_PORTS
+#    if !defined(PROTOCOL_CHIBIOS)
+#        error "MATRIX_SCAN_PORTS is only supported on ChibiOS"
+#    elif defined(DIRECT_PINS)
+#        error "MATRIX_SCAN_PORTS is not supported with DIRECT_PINS"
+#    elif (DIODE_DIRECTION == ROW2COL) && (ROWS_PER_HAND > 32)
+#        error "MATRIX_SCAN_PORTS supports at most 32 rows per hand with ROW2COL"
+#    endif
+#endif
+
+#ifdef MATRIX_SCAN_ON_INTERRUPT
+#    if !defined(PROTOCOL_CHIBIOS)
+#        error "MATRIX_SCAN_ON_INTERRUPT is only supported on ChibiOS"
+#    elif !PAL_USE_CALLBACKS
+#        error "MATRIX_SCAN_ON_INTERRUPT requires PAL_USE_CALLBACKS to be enabled in halconf.h"
+#    endif
+#    ifndef MATRIX_SCAN_IDLE_TIME
+#        ifdef DEBOUNCE
+#            define MATRIX_SCAN_IDLE_TIME (DEBOUNCE + 1)
+#        else
+#            define MATRIX_SCAN_IDLE_TIME 6
+#        endif
+#    endif
+#endif
+
 #ifdef DIRECT_PINS
 static SPLIT_MUTABLE pin_t direct_pins[ROWS_PER_HAND][MATRIX_COLS] = DIRECT_PINS;
 #elif (DIODE_DIRECTION == ROW2COL) || (DIODE_DIRECTION == COL2ROW)
@@ -104,6 +132,142 @@ static inline uint8_t readMatrixPin(pin_t pin) {
     }
 }
 
+#ifdef MATRIX_SCAN_ON_INTERRUPT
+#    if defined(DIRECT_PINS)
+#        define MATRIX_INTERRUPT_INPUT_COUNT (ROWS_PER_HAND * MATRIX_COLS)
+#    elif (DIODE_DIRECTION == ROW2COL)
+#        define MATRIX_INTERRUPT_INPUT_COUNT ROWS_PER_HAND
+#    else
+#        define MATRIX_INTERRUPT_INPUT_COUNT MATRIX_COLS
+#    endif
+
+static void matrix_edge_callback(void *arg);
+
+// Inputs without a line event of their own, read on every scan and every wakeup while armed
+static pin_t   matrix_polled_inputs[MATRIX_INTERRUPT_INPUT_COUNT];
+static uint8_t matrix_polled_input_count = 0;
+
+/* On STM32, an EXTI line serves the pads with the same number on every port, so only the first input of each pad
+ * number can get a line event. Later inputs sharing it are left to polling.
+ */
+static bool matrix_input_has_line_event(const pin_t inputs[], uint16_t index) {
+#    if defined(MCU_STM32)
+    for (uint16_t other = 0; other < index; other++) {
+        if (inputs[other] != NO_PIN && inputs[other] != inputs[index] && PAL_PAD(inputs[other]) == PAL_PAD(inputs[index])) {
+            return false;
+        }
+    }
+#    endif
+    return true;
+}
+
+// Returns true if the input already reads as pressed
+static bool matrix_interrupt_arm_input(const pin_t inputs[], uint16_t index) {
+    pin_t pin = inputs[index];
+    if (pin == NO_PIN) {
+        return false;
+    }
+    if (matrix_input_has_line_event(inputs, index)) {
+        palEnableLineEvent(pin, PAL_EVENT_MODE_BOTH_EDGES);
+        palSetLineCallback(pin, matrix_edge_callback, NULL);
+    } else {
+        matrix_polled_inputs[matrix_polled_input_count++] = pin;
+    }
+    return !readMatrixPin(pin);
+}
+
+static void matrix_interrupt_disarm_input(const pin_t inputs[], uint16_t index) {
+    if (inputs[index] != NO_PIN && matrix_input_has_line_event(inputs, index)) {
+        palDisableLineEvent(inputs[index]);
+    }
+}
+#endif // MATRIX_SCAN_ON_INTERRUPT
+
+#ifdef MATRIX_SCAN_PORTS
+#    if (DIODE_DIRECTION == ROW2COL)
+#        define MATRIX_INPUT_COUNT ROWS_PER_HAND
+#    else
+#        define MATRIX_INPUT_COUNT MATRIX_COLS
+#    endif
+
+// A run of input pins with consecutive pads on the same port, mapped to consecutive bits of the result
+typedef struct {
+    uint8_t      port_index;
+    uint8_t      pad_shift;
+    uint8_t      bit_shift;
+    ioportmask_t mask;
+} matrix_input_run_t;
+
+static ioportid_t         matrix_input_ports[MATRIX_INPUT_COUNT];
+static uint8_t            matrix_input_port_count = 0;
+static matrix_input_run_t matrix_input_runs[MATRIX_INPUT_COUNT];
+static uint8_t            matrix_input_run_count = 0;
+
+/* Groups the input pins by GPIO port, so that every input can be read with a single register access per port.
+ * Executed once at init, as the pin arrays of the right half of a split are only known at runtime.
+ */
+static void matrix_input_runs_init(const pin_t pins[], uint8_t count) {
+    matrix_input_port_count = 0;
+    matrix_input_run_count  = 0;
+
+    for (uint8_t index = 0; index < count; index++) {
+        pin_t pin = pins[index];
+        if (pin == NO_PIN) {
+            continue;
+        }
+
+        ioportid_t port       = PAL_PORT(pin);
+        uint8_t    pad        = PAL_PAD(pin);
+        uint8_t    port_index = 0;
+        while (port_index < matrix_input_port_count && matrix_input_ports[port_index] != port) {
+            port_index++;
+        }
+        if (port_index == matrix_input_port_count) {
+            matrix_input_ports[matrix_input_port_count++] = port;
+        }
+
+        // Extend the previous run if this pin directly follows it, both on the port and in the matrix
+        if (matrix_input_run_count > 0) {
+            matrix_input_run_t *run   = &matrix_input_runs[matrix_input_run_count - 1];
+            uint8_t             width = 0;
+            while (run->mask >> width) {
+                width++;
+            }
+            if (run->port_index == port_index && run->pad_shift + width == pad && run->bit_shift + width == index) {
+                run->mask |= (ioportmask_t)1 << width;
+                continue;
+            }
+        }
+
+        matrix_input_runs[matrix_input_run_count++] = (matrix_input_run_t){
+            .port_index = port_index,
+            .pad_shift  = pad,
+            .bit_shift  = index,
+            .mask       = 1,
+        };
+    }
+}
+
+/* Returns a bitmap of the pressed inputs, bit n corresponding to the nth entry of the input pin array */
+static inline uint32_t matrix_read_inputs(void) {
+    ioportmask_t port_state[MATRIX_INPUT_COUNT];
+    for (uint8_t i = 0; i < matrix_input_port_count; i++) {
+#    if MATRIX_INPUT_PRESSED_STATE == 0
+        port_state[i] = ~palReadPort(matrix_input_ports[i]);
+#    else
+        port_state[i] = palReadPort(matrix_input_ports[i]);
+#    endif
+    }
+
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < matrix_input_run_count; i++) {
+        const matrix_input_run_t *run = &matrix_input_runs[i];
+        value |= (uint32_t)((port_state[run->port_index] >> run->pad_shift) & run->mask) << run->bit_shift;
+    }
+    return value;
+}
+#endif // MATRIX_SCAN_PORTS
+
 // matrix code
 
 #ifdef DIRECT_PINS
@@ -133,6 +297,22 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#    ifdef MATRIX_SCAN_ON_INTERRUPT
+static bool matrix_interrupt_arm_lines(void) {
+    bool pressed = false;
+    for (uint16_t index = 0; index < MATRIX_INTERRUPT_INPUT_COUNT; index++) {
+        pressed |= matrix_interrupt_arm_input(&direct_pins[0][0], index);
+    }
+    return pressed;
+}
+
+static void matrix_interrupt_disarm_lines(void) {
+    for (uint16_t index = 0; index < MATRIX_INTERRUPT_INPUT_COUNT; index++) {
+        matrix_interrupt_disarm_input(&direct_pins[0][0], index);
+    }
+}
+#    endif // MATRIX_SCAN_ON_INTERRUPT
+
 #elif defined(DIODE_DIRECTION)
 #    if defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
 #        if (DIODE_DIRECTION == COL2ROW)
@@ -181,6 +361,10 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_SCAN_PORTS
+    // Read all cols at once, one register access per port
+    current_row_value = (matrix_row_t)matrix_read_inputs();
+#            else
     // For each col...
     matrix_row_t row_shifter = MATRIX_ROW_SHIFTER;
     for (uint8_t col_index = 0; col_index < MATRIX_COLS; col_index++, row_shifter <<= 1) {
@@ -189,6 +373,7 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
         // Populate the matrix row with the state of the col pin
         current_row_value |= pin_state ? 0 : row_shifter;
     }
+#            endif
 
     // Unselect row
     unselect_row(current_row);
@@ -198,6 +383,30 @@ __attribute__((weak)) void matrix_read_cols_on_row(matrix_row_t current_matrix[]
     current_matrix[current_row] = current_row_value;
 }
 
+#            ifdef MATRIX_SCAN_ON_INTERRUPT
+// Select every row at once, so that a press anywhere in the matrix pulls its column low
+static bool matrix_interrupt_arm_lines(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        select_row(row);
+    }
+    matrix_output_select_delay();
+
+    bool pressed = false;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        pressed |= matrix_interrupt_arm_input(col_pins, col);
+    }
+    return pressed;
+}
+
+static void matrix_interrupt_disarm_lines(void) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        matrix_interrupt_disarm_input(col_pins, col);
+    }
+    unselect_rows();
+    matrix_output_unselect_delay(0, true);
+}
+#            endif // MATRIX_SCAN_ON_INTERRUPT
+
 #        elif (DIODE_DIRECTION == ROW2COL)
 
 static bool select_col(uint8_t col) {
@@ -244,6 +453,18 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
     }
     matrix_output_select_delay();
 
+#            ifdef MATRIX_SCAN_PORTS
+    // Read all rows at once, one register access per port
+    uint32_t rows_pressed = matrix_read_inputs();
+    key_pressed           = rows_pressed != 0;
+    for (uint8_t row_index = 0; row_index < ROWS_PER_HAND; row_index++, rows_pressed >>= 1) {
+        if (rows_pressed & 1) {
+            current_matrix[row_index] |= row_shifter;
+        } else {
+            current_matrix[row_index] &= ~row_shifter;
+        }
+    }
+#            else
     // For each row...
     for (uint8_t row_index = 0; row_index < ROWS_PER_HAND; row_index++) {
         // Check row pin state
@@ -256,12 +477,37 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
             current_matrix[row_index] &= ~row_shifter;
         }
     }
+#            endif
 
     // Unselect col
     unselect_col(current_col);
     matrix_output_unselect_delay(current_col, key_pressed); // wait for all Row signals to go HIGH
 }
 
+#            ifdef MATRIX_SCAN_ON_INTERRUPT
+// Select every column at once, so that a press anywhere in the matrix pulls its row low
+static bool matrix_interrupt_arm_lines(void) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        select_col(col);
+    }
+    matrix_output_select_delay();
+
+    bool pressed = false;
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        pressed |= matrix_interrupt_arm_input(row_pins, row);
+    }
+    return pressed;
+}
+
+static void matrix_interrupt_disarm_lines(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        matrix_interrupt_disarm_input(row_pins, row);
+    }
+    unselect_cols();
+    matrix_output_unselect_delay(0, true);
+}
+#            endif // MATRIX_SCAN_ON_INTERRUPT
+
 #        else
 #            error DIODE_DIRECTION must be one of COL2ROW or ROW2COL!
 #        endif
@@ -270,6 +516,68 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_SCAN_ON_INTERRUPT
+static binary_semaphore_t matrix_edge_semaphore;
+static volatile bool      matrix_edge_pending  = false;
+static bool               matrix_armed         = false;
+static uint32_t           matrix_last_activity = 0;
+
+static void matrix_edge_callback(void *arg) {
+    matrix_edge_pending = true;
+    chSysLockFromISR();
+    chBSemSignalI(&matrix_edge_semaphore);
+    chSysUnlockFromISR();
+}
+
+static void matrix_interrupt_arm(void) {
+    chBSemReset(&matrix_edge_semaphore, true);
+    matrix_edge_pending       = false;
+    matrix_armed              = true;
+    matrix_polled_input_count = 0;
+    // Catch any edge that happened between the last scan and the events being enabled
+    if (matrix_interrupt_arm_lines()) {
+        matrix_edge_pending = true;
+    }
+}
+
+static void matrix_interrupt_disarm(void) {
+    matrix_interrupt_disarm_lines();
+    matrix_armed         = false;
+    matrix_edge_pending  = false;
+    matrix_last_activity = timer_read32();
+}
+
+// Returns true once an edge is pending, after reading the inputs that have no line event
+static bool matrix_interrupt_poll(void) {
+    for (uint8_t i = 0; i < matrix_polled_input_count && !matrix_edge_pending; i++) {
+        if (!readMatrixPin(matrix_polled_inputs[i])) {
+            matrix_edge_pending = true;
+        }
+    }
+    return matrix_edge_pending;
+}
+
+bool matrix_is_idle(void) {
+    return matrix_armed && !matrix_edge_pending;
+}
+
+bool matrix_sleep_until_change(uint32_t timeout_ms) {
+    if (!matrix_armed || matrix_edge_pending) {
+        return true;
+    }
+    if (matrix_polled_input_count == 0) {
+        chBSemWaitTimeout(&matrix_edge_semaphore, timeout_ms ? TIME_MS2I(timeout_ms) : TIME_INFINITE);
+        return matrix_edge_pending;
+    }
+    // Wake up every millisecond to read the inputs that cannot signal an edge themselves
+    uint32_t start = timer_read32();
+    while (!matrix_interrupt_poll() && (!timeout_ms || timer_elapsed32(start) < timeout_ms)) {
+        chBSemWaitTimeout(&matrix_edge_semaphore, TIME_MS2I(1));
+    }
+    return matrix_edge_pending;
+}
+#endif // MATRIX_SCAN_ON_INTERRUPT
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -303,6 +611,19 @@ void matrix_init(void) {
     // initialize key pins
     matrix_init_pins();
 
+#ifdef MATRIX_SCAN_PORTS
+#    if (DIODE_DIRECTION == ROW2COL)
+    matrix_input_runs_init(row_pins, ROWS_PER_HAND);
+#    else
+    matrix_input_runs_init(col_pins, MATRIX_COLS);
+#    endif
+#endif
+
+#ifdef MATRIX_SCAN_ON_INTERRUPT
+    chBSemObjectInit(&matrix_edge_semaphore, true);
+    matrix_last_activity = timer_read32();
+#endif
+
     // initialize matrix state: all keys off
     memset(matrix, 0, sizeof(matrix));
     memset(raw_matrix, 0, sizeof(raw_matrix));
@@ -320,9 +641,7 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 }
 #endif
 
-uint8_t matrix_scan(void) {
-    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
-
+static inline void matrix_read(matrix_row_t curr_matrix[]) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
@@ -335,6 +654,23 @@ uint8_t matrix_scan(void) {
         matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
     }
 #endif
+}
+
+uint8_t matrix_scan(void) {
+    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
+
+#ifdef MATRIX_SCAN_ON_INTERRUPT
+    // While armed, all keys are released and nothing is debouncing, so the previous (empty) state is reused until an
+    // edge is seen on one of the input lines, or one of the polled inputs reads as pressed
+    if (matrix_armed && matrix_interrupt_poll()) {
+        matrix_interrupt_disarm();
+    }
+    if (!matrix_armed) {
+        matrix_read(curr_matrix);
+    }
+#else
+    matrix_read(curr_matrix);
+#endif
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
@@ -345,5 +681,24 @@ uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
     matrix_scan_kb();
 #endif
+
+#ifdef MATRIX_SCAN_ON_INTERRUPT
+    if (!matrix_armed) {
+        // Keep scanning at full speed while any key is held, or until the debounce windows have closed
+        bool idle = true;
+        for (uint8_t row = 0; row < ROWS_PER_HAND && idle; row++) {
+#    ifdef SPLIT_KEYBOARD
+            idle = !raw_matrix[row] && !matrix[thisHand + row];
+#    else
+            idle = !raw_matrix[row] && !matrix[row];
+#    endif
+        }
+        if (!idle || changed) {
+            matrix_last_activity = timer_read32();
+        } else if (timer_elapsed32(matrix_last_activity) >= MATRIX_SCAN_IDLE_TIME) {
+            matrix_interrupt_arm();
+        }
+    }
+#endif
     return (uint8_t)changed;
 }
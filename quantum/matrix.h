@@ -65,6 +65,13 @@ void matrix_output_unselect_delay(uint8_t line, bool key_pressed);
 /* only for backwards compatibility. delay between changing matrix pin state and reading values */
 void matrix_io_delay(void);
 
+#ifdef MATRIX_SCAN_ON_INTERRUPT
+/* whether the matrix is idle and waiting for an input edge instead of being scanned */
+bool matrix_is_idle(void);
+/* block until an input edge occurs or the timeout (0 for none) expires, returns true if an edge occurred */
+bool matrix_sleep_until_change(uint32_t timeout_ms);
+#endif
+
 /* power control */
 void matrix_power_up(void);
 void matrix_power_down(void);
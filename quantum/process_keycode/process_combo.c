@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -26,6 +27,7 @@
 #include "action_tapping.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "print.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -102,6 +104,101 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+/* Inverted index from keycode to the combos containing it, sorted by keycode and then by combo index, so that a key
+ * event only has to visit the combos it is part of. Built on first use, and rebuilt when the number of combos changes.
+ * The storage is sized at compile time by the keymap introspection. */
+static combo_index_entry_t *combo_index_entries = NULL;
+static uint16_t             combo_index_size    = 0;
+static uint16_t             combo_index_count   = 0;
+static bool                 combo_index_valid   = false;
+static bool                 combo_index_fits    = false;
+
+/* Combos whose state may need to be reset by clear_combos(), one bit per combo. */
+static uint8_t *combo_touched = NULL;
+
+#define COMBO_IS_TOUCHED(index) (combo_touched[(index) / 8] & (1 << ((index) % 8)))
+#define TOUCH_COMBO(index)                                  \
+    do {                                                    \
+        combo_touched[(index) / 8] |= (1 << ((index) % 8)); \
+    } while (0)
+#define UNTOUCH_COMBO(index)                                 \
+    do {                                                     \
+        combo_touched[(index) / 8] &= ~(1 << ((index) % 8)); \
+    } while (0)
+
+static void build_combo_index(void) {
+    combo_index_size  = 0;
+    combo_index_count = combo_count();
+    combo_index_valid = true;
+    combo_index_fits  = false;
+
+    uint16_t entry_capacity, combo_capacity;
+    combo_index_entries = combo_index_entries_raw(&entry_capacity);
+    combo_touched       = combo_index_flags_raw(&combo_capacity);
+
+    // Only combos added at runtime through combo_count() and combo_get(), or a COMBO_INDEX_SIZE set too small, can
+    // exceed the storage
+    uint16_t size = 0;
+    for (uint16_t idx = 0; idx < combo_index_count; ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        for (uint8_t i = 0; pgm_read_word(&keys[i]) != COMBO_END; ++i) {
+            ++size;
+        }
+    }
+    if (size > entry_capacity || combo_index_count > combo_capacity) {
+        uprintf("COMBO: %u keys of %u combos do not fit the index (%u keys of %u combos), checking every combo instead\n", size, combo_index_count, entry_capacity, combo_capacity);
+        return;
+    }
+    combo_index_fits = true;
+    // Combo states may be left over from before the rebuild, so have the next clear_combos() visit all of them
+    memset(combo_touched, 0xFF, (combo_index_count + 7) / 8);
+
+    // Combos are visited in order and the index is built once, so an insertion sort is all it takes
+    for (uint16_t idx = 0; idx < combo_index_count; ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        for (uint8_t i = 0; (key = pgm_read_word(&keys[i])) != COMBO_END; ++i) {
+            uint16_t pos = combo_index_size;
+            while (pos > 0 && combo_index_entries[pos - 1].keycode > key) {
+                --pos;
+            }
+            // A keycode listed twice in the same combo must only process that combo once
+            if (pos > 0 && combo_index_entries[pos - 1].keycode == key && combo_index_entries[pos - 1].combo_index == idx) {
+                continue;
+            }
+            memmove(&combo_index_entries[pos + 1], &combo_index_entries[pos], (combo_index_size - pos) * sizeof(combo_index_entry_t));
+            combo_index_entries[pos] = (combo_index_entry_t){
+                .keycode     = key,
+                .combo_index = idx,
+            };
+            ++combo_index_size;
+        }
+    }
+}
+
+static inline bool combo_index_is_usable(void) {
+    return combo_index_valid && combo_index_fits && combo_index_count == combo_count();
+}
+
+/* Returns the position of the first index entry for the keycode, or combo_index_size if there is none. */
+static uint16_t find_combo_index_entry(uint16_t keycode) {
+    uint16_t low  = 0;
+    uint16_t high = combo_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_index_entries[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+void combo_index_invalidate(void) {
+    combo_index_valid = false;
+}
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -202,6 +299,24 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+    if (combo_index_is_usable()) {
+        // Only combos that have been processed since they were last reset can have a state to clear
+        for (index = 0; index < combo_index_count; ++index) {
+            if (!combo_touched[index / 8]) {
+                index |= 7; // skip the rest of this byte
+                continue;
+            }
+            if (COMBO_IS_TOUCHED(index)) {
+                combo_t *combo = combo_get(index);
+                if (!COMBO_ACTIVE(combo)) {
+                    RESET_COMBO_STATE(combo);
+                    UNTOUCH_COMBO(index);
+                }
+            }
+        }
+        return;
+    }
+
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
@@ -264,7 +379,6 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -552,8 +666,7 @@ static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode,
 }
 
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    uint8_t is_combo_key          = COMBO_KEY_NOT_PRESSED;
-    bool    no_combo_keys_pressed = true;
+    uint8_t is_combo_key = COMBO_KEY_NOT_PRESSED;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -581,10 +694,21 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+    if (!combo_index_valid || combo_index_count != combo_count()) {
+        build_combo_index();
+    }
+
+    if (combo_index_fits) {
+        // Only visit the combos containing this keycode, in combo order
+        for (uint16_t i = find_combo_index_entry(keycode); i < combo_index_size && combo_index_entries[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_index_entries[i].combo_index;
+            TOUCH_COMBO(idx);
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
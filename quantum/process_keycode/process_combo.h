@@ -57,6 +57,12 @@ typedef struct combo_t {
 #endif
 } combo_t;
 
+/* Entry of the index from keycode to the combos containing it, see combo_index_entries_raw() */
+typedef struct combo_index_entry_t {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_index_entry_t;
+
 #define COMBO(ck, ca) \
     { .keys = &(ck)[0], .keycode = (ca) }
 #define COMBO_ACTION(ck) \
@@ -81,3 +87,7 @@ void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
 bool is_combo_enabled(void);
+
+/* Combos are looked up through an index built from combo_count() and combo_get() on first use. Call this after
+ * changing the keys of existing combos at runtime, changes to the number of combos are picked up automatically. */
+void combo_index_invalidate(void);
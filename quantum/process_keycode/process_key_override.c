@@ -16,22 +16,22 @@
  */
 
 #include "process_key_override.h"
+#include <string.h>
 #include "report.h"
 #include "timer.h"
 #include "debug.h"
+#include "print.h"
 #include "wait.h"
 #include "action_util.h"
 #include "quantum.h"
 #include "quantum_keycodes.h"
 #include "keymap_introspection.h"
+#include "profiler.h"
 
 #ifndef KEY_OVERRIDE_REPEAT_DELAY
 #    define KEY_OVERRIDE_REPEAT_DELAY 500
 #endif
 
-// For benchmarking the time it takes to call process_key_override on every key press (needs keyboard debugging enabled as well)
-// #define BENCH_KEY_OVERRIDE
-
 // For debug output (needs keyboard debugging enabled as well)
 // #define DEBUG_KEY_OVERRIDE
 
@@ -84,9 +84,83 @@ static uint16_t deferred_register = 0;
 // TODO: in future maybe save in EEPROM?
 static bool enabled = true;
 
+// Index of the key overrides sorted by trigger keycode and then by position in the key_overrides array, so that a key event only has to evaluate the overrides whose trigger can possibly be down. The modifier masks are copied into the index to reject overrides that cannot match the active modifiers without touching the override itself. Built on first use, and rebuilt when the number of overrides changes. The storage is sized at compile time by the keymap introspection.
+static key_override_index_entry_t *key_override_index_entries = NULL;
+static uint16_t                    key_override_index_size    = 0;
+static uint16_t                    key_override_index_count   = 0;
+static bool                        key_override_index_valid   = false;
+static bool                        key_override_index_fits    = false;
+
 // Forward decls
 static const key_override_t *clear_active_override(const bool allow_reregister);
 
+static void build_key_override_index(void) {
+    key_override_index_size  = 0;
+    key_override_index_count = key_override_count();
+    key_override_index_valid = true;
+
+    // Only key overrides added at runtime through key_override_count() and key_override_get() can exceed the storage
+    uint16_t capacity;
+    key_override_index_entries = key_override_index_entries_raw(&capacity);
+    key_override_index_fits    = key_override_index_count <= capacity;
+
+    if (!key_override_index_fits) {
+        uprintf("Key overrides do not fit the index (%u of %u), checking every key override instead\n", key_override_index_count, capacity);
+        return;
+    }
+
+    // Overrides are visited in order and the index is built once, so an insertion sort is all it takes
+    for (uint16_t i = 0; i < key_override_index_count; i++) {
+        const key_override_t *const override = key_override_get(i);
+
+        // End of array
+        if (override == NULL) {
+            break;
+        }
+
+        uint16_t pos = key_override_index_size;
+        while (pos > 0 && key_override_index_entries[pos - 1].trigger > override->trigger) {
+            pos--;
+        }
+        memmove(&key_override_index_entries[pos + 1], &key_override_index_entries[pos], (key_override_index_size - pos) * sizeof(key_override_index_entry_t));
+        key_override_index_entries[pos] = (key_override_index_entry_t){
+            .trigger           = override->trigger,
+            .override_index    = i,
+            .trigger_mods      = override->trigger_mods,
+            .negative_mod_mask = override->negative_mod_mask,
+        };
+        key_override_index_size++;
+    }
+}
+
+static inline bool key_override_index_is_usable(void) {
+    return key_override_index_valid && key_override_index_fits && key_override_index_count == key_override_count();
+}
+
+// Returns the position of the first index entry for the trigger, or key_override_index_size if there is none.
+static uint16_t find_key_override_index_entry(const uint16_t trigger) {
+    uint16_t low  = 0;
+    uint16_t high = key_override_index_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (key_override_index_entries[mid].trigger < trigger) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Cheap necessary condition for key_override_matches_active_modifiers(): no negative mod may be down, and at least one trigger mod must be down if any are required.
+static inline bool key_override_index_entry_may_match(const key_override_index_entry_t *entry, const uint8_t mods) {
+    return (entry->negative_mod_mask & mods) == 0 && (entry->trigger_mods == 0 || (entry->trigger_mods & mods) != 0);
+}
+
+void key_override_index_invalidate(void) {
+    key_override_index_valid = false;
+}
+
 void key_override_on(void) {
     enabled = true;
     key_override_printf("Key override ON\n");
@@ -243,150 +317,224 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_override_count() == 0) {
-        return true;
+/** Checks whether the provided override should be activated by the key event. */
+static bool override_should_activate(const key_override_t *override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0; i < key_override_count(); i++) {
-        const key_override_t *const override = key_override_get(i);
-
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
-        }
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
 
-        const bool is_trigger = override->trigger == keycode;
+    // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
+    const bool no_trigger = override->trigger == KC_NO;
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
-        }
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
-        }
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
-        }
+    // Check if trigger key is down.
+    const bool trigger_down = is_trigger && key_down;
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required, yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
 
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    if (!should_activate) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+    return true;
+}
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
-            continue;
-        }
+/** Activates the provided override. Returns true if the key action for `keycode` should be sent */
+static bool activate_override(const key_override_t *override, const uint16_t keycode, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    const bool trigger_down = override->trigger == keycode && key_down;
+    const bool no_trigger   = override->trigger == KC_NO;
 
-        key_override_printf("Activating override\n");
+    key_override_printf("Activating override\n");
 
-        clear_active_override(false);
+    clear_active_override(false);
 
 #ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
-        // Send a dummy keycode before unregistering the modifier(s)
-        // so that suppressing the modifier(s) doesn't falsely get interpreted
-        // by the host OS as a tap of a modifier key.
-        // For example, unintended activations of the start menu on Windows when
-        // using a GUI+<kc> key override with suppressed mods.
-        neutralize_flashing_modifiers(active_mods);
+    // Send a dummy keycode before unregistering the modifier(s)
+    // so that suppressing the modifier(s) doesn't falsely get interpreted
+    // by the host OS as a tap of a modifier key.
+    // For example, unintended activations of the start menu on Windows when
+    // using a GUI+<kc> key override with suppressed mods.
+    neutralize_flashing_modifiers(active_mods);
 #endif
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
+    active_override                 = override;
+    active_override_trigger_is_down = true;
 
-        set_suppressed_override_mods(override->suppressed_mods);
+    set_suppressed_override_mods(override->suppressed_mods);
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_BASIC_KEYCODE(override->trigger)) {
-                del_key(override->trigger);
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_BASIC_KEYCODE(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
+        }
+    }
+
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
+
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
+
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_BASIC_KEYCODE(mod_free_replacement)) {
+                add_key(mod_free_replacement);
             } else {
-                unregister_code(override->trigger);
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                wait_ms(10);
+                register_code(mod_free_replacement);
             }
         }
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
+    }
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    return !trigger_down;
+}
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+/** Tries activating the key overrides whose trigger can be down during this event, in the order of the key_overrides array, until it finds one that activates or runs out of candidates. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    *activated = false;
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
-        }
+    if (key_override_count() == 0) {
+        return true;
+    }
+
+    if (!key_override_index_valid || key_override_index_count != key_override_count()) {
+        build_key_override_index();
+    }
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
+    if (!key_override_index_is_usable()) {
+        for (uint16_t i = 0; i < key_override_count(); i++) {
+            const key_override_t *const override = key_override_get(i);
 
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
-            } else {
-                if (IS_BASIC_KEYCODE(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
-                }
+            // End of array
+            if (override == NULL) {
+                break;
+            }
+
+            if (override_should_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+                *activated = true;
+                return activate_override(override, keycode, key_down, is_mod, active_mods);
             }
-        } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
         }
+        return true;
+    }
 
-        *activated = true;
+    // An override can only activate if it has no trigger, if its trigger is the key of this event, or if its trigger is the last non-mod key pressed down. Merge these (at most three) runs of the index to visit the candidates in array order.
+    const uint16_t triggers[]                      = {KC_NO, keycode, last_key_down};
+    uint16_t       run_begin[ARRAY_SIZE(triggers)] = {0};
+    uint16_t       run_end[ARRAY_SIZE(triggers)]   = {0};
+    uint8_t        run_count                       = 0;
 
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+    for (uint8_t i = 0; i < ARRAY_SIZE(triggers); i++) {
+        bool duplicate = false;
+        for (uint8_t j = 0; j < i; j++) {
+            duplicate |= triggers[j] == triggers[i];
+        }
+        if (duplicate) {
+            continue;
+        }
+
+        uint16_t begin = find_key_override_index_entry(triggers[i]);
+        uint16_t end   = begin;
+        while (end < key_override_index_size && key_override_index_entries[end].trigger == triggers[i]) {
+            end++;
+        }
+        if (begin != end) {
+            run_begin[run_count] = begin;
+            run_end[run_count]   = end;
+            run_count++;
+        }
     }
 
-    *activated = false;
+    while (true) {
+        int8_t next = -1;
+        for (uint8_t i = 0; i < run_count; i++) {
+            if (run_begin[i] < run_end[i] && (next < 0 || key_override_index_entries[run_begin[i]].override_index < key_override_index_entries[run_begin[next]].override_index)) {
+                next = i;
+            }
+        }
+        if (next < 0) {
+            break;
+        }
+
+        const key_override_index_entry_t *const entry = &key_override_index_entries[run_begin[next]++];
+
+        if (!key_override_index_entry_may_match(entry, active_mods)) {
+            key_override_printf("Not activating override: Modifiers don't match\n");
+            continue;
+        }
+
+        const key_override_t *const override = key_override_get(entry->override_index);
+
+        if (override != NULL && override_should_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+            *activated = true;
+            return activate_override(override, keycode, key_down, is_mod, active_mods);
+        }
+    }
 
     return true;
 }
@@ -405,11 +553,7 @@ void key_override_task(void) {
     }
 }
 
-bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
-#ifdef BENCH_KEY_OVERRIDE
-    uint16_t start = timer_read();
-#endif
-
+static bool process_key_override_event(const uint16_t keycode, const keyrecord_t *const record) {
     const bool key_down = record->event.pressed;
     const bool is_mod   = IS_MODIFIER_KEYCODE(keycode);
 
@@ -519,11 +663,11 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
         }
     }
 
-#ifdef BENCH_KEY_OVERRIDE
-    uint16_t elapsed = timer_elapsed(start);
-
-    dprintf("Processing key overrides took: %u ms\n", elapsed);
-#endif
+    return send_key_action;
+}
 
+bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
+    bool send_key_action;
+    PROFILER_PROBE(PROCESS_KEY_OVERRIDE, send_key_action = process_key_override_event(keycode, record));
     return send_key_action;
 }
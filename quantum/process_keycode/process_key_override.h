@@ -87,6 +87,14 @@ typedef struct key_override_t {
     bool *enabled;
 } key_override_t;
 
+/** Entry of the index of key overrides by trigger, see key_override_index_entries_raw(). The modifier masks are copied from the key override. */
+typedef struct key_override_index_entry_t {
+    uint16_t trigger;
+    uint16_t override_index;
+    uint8_t  trigger_mods;
+    uint8_t  negative_mod_mask;
+} key_override_index_entry_t;
+
 /** Turns key overrides on */
 void key_override_on(void);
 
@@ -105,6 +113,9 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
 /** Perform any deferred keys */
 void key_override_task(void);
 
+/** Rebuilds the trigger lookup on the next key event. Call after modifying the trigger, trigger_mods or negative_mod_mask of a key override at runtime */
+void key_override_index_invalidate(void);
+
 /**
  *  Preferrably use these macros to create key overrides. They fix many of the options to a standard setting that should satisfy most basic use-cases. Only directly create a key_override_t struct when you really need to.
  */
@@ -0,0 +1,257 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include <string.h>
+#include "profiler.h"
+#include "timer.h"
+#include "debug.h"
+#include "util.h"
+
+#if defined(__AVR__)
+#    include <avr/io.h>
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+#elif defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_ticks;
+    uint32_t max_ticks;
+    uint64_t total_ticks;
+    uint16_t histogram[PROFILER_HISTOGRAM_BUCKETS];
+} profiler_probe_state_t;
+
+static profiler_probe_state_t profiler_probes[PROFILER_PROBE_COUNT];
+
+#define PROFILER_PROBE_NAME(id, name) [PROFILER_PROBE_##id] = name,
+static const char *const profiler_probe_names[PROFILER_PROBE_COUNT] = {PROFILER_PROBES(PROFILER_PROBE_NAME)};
+#undef PROFILER_PROBE_NAME
+
+//------------------------------------
+// Timestamps
+//
+
+#if defined(__AVR__)
+extern volatile uint32_t timer_count;
+
+// Timer0 counts from 0 to TIMER_RAW_TOP once per millisecond, combine it with the millisecond counter
+uint32_t profiler_timestamp(void) {
+    uint32_t ms;
+    uint8_t  raw;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_count;
+        raw = TIMER_RAW;
+#    if defined(TIFR0) && defined(OCF0A)
+        // The counter may have wrapped after interrupts were disabled, before the millisecond counter was updated
+        if ((TIFR0 & _BV(OCF0A)) && raw < TIMER_RAW_TOP / 2) {
+            ms++;
+        }
+#    endif
+    }
+    return ms * (TIMER_RAW_TOP + 1) + raw;
+}
+
+uint32_t profiler_timestamp_frequency(void) {
+    return (TIMER_RAW_TOP + 1) * 1000UL;
+}
+#elif defined(PROTOCOL_CHIBIOS) && PORT_SUPPORTS_RT
+// Core cycle counter
+uint32_t profiler_timestamp(void) {
+    return chSysGetRealtimeCounterX();
+}
+
+uint32_t profiler_timestamp_frequency(void) {
+#    if defined(STM32_HCLK)
+    return STM32_HCLK;
+#    else
+    return 0;
+#    endif
+}
+#else
+uint32_t profiler_timestamp(void) {
+    return timer_read32();
+}
+
+uint32_t profiler_timestamp_frequency(void) {
+    return 1000;
+}
+#endif
+
+//------------------------------------
+// Recording
+//
+
+static uint8_t histogram_bucket(uint32_t ticks) {
+    uint8_t bucket = 0;
+    while (ticks && bucket < PROFILER_HISTOGRAM_BUCKETS - 1) {
+        ticks >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void profiler_record(profiler_probe_t probe, uint32_t ticks) {
+    if (probe >= PROFILER_PROBE_COUNT) {
+        return;
+    }
+
+    profiler_probe_state_t *state = &profiler_probes[probe];
+    if (state->count == UINT32_MAX) {
+        return;
+    }
+    if (state->count == 0 || ticks < state->min_ticks) {
+        state->min_ticks = ticks;
+    }
+    if (ticks > state->max_ticks) {
+        state->max_ticks = ticks;
+    }
+    state->total_ticks += ticks;
+    state->count++;
+
+    uint16_t *bucket = &state->histogram[histogram_bucket(ticks)];
+    if (*bucket == UINT16_MAX) {
+        // Halve every bucket instead of saturating, which keeps the distribution intact
+        for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+            state->histogram[i] /= 2;
+        }
+    }
+    (*bucket)++;
+}
+
+void profiler_reset(void) {
+    memset(profiler_probes, 0, sizeof(profiler_probes));
+}
+
+//------------------------------------
+// Reporting
+//
+
+static uint32_t histogram_percentile(const profiler_probe_state_t *state, uint8_t percent) {
+    uint32_t samples = 0;
+    for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS; i++) {
+        samples += state->histogram[i];
+    }
+
+    uint32_t target     = (samples * percent + 99) / 100;
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < PROFILER_HISTOGRAM_BUCKETS - 1; i++) {
+        cumulative += state->histogram[i];
+        if (cumulative >= target) {
+            // Bucket i holds the durations of i significant bits
+            uint32_t upper = i == 0 ? 0 : (i >= 32 ? UINT32_MAX : (1UL << i) - 1);
+            return MIN(upper, state->max_ticks);
+        }
+    }
+    return state->max_ticks;
+}
+
+bool profiler_get_stats(profiler_probe_t probe, profiler_stats_t *stats) {
+    if (probe >= PROFILER_PROBE_COUNT) {
+        return false;
+    }
+
+    const profiler_probe_state_t *state = &profiler_probes[probe];
+
+    stats->count     = state->count;
+    stats->min_ticks = state->min_ticks;
+    stats->max_ticks = state->max_ticks;
+    stats->avg_ticks = state->count ? state->total_ticks / state->count : 0;
+    stats->p99_ticks = state->count ? histogram_percentile(state, 99) : 0;
+    return true;
+}
+
+const char *profiler_get_name(profiler_probe_t probe) {
+    if (probe >= PROFILER_PROBE_COUNT) {
+        return NULL;
+    }
+    return profiler_probe_names[probe];
+}
+
+static uint8_t *write_u32(uint8_t *buffer, uint32_t value) {
+    buffer[0] = value & 0xFF;
+    buffer[1] = (value >> 8) & 0xFF;
+    buffer[2] = (value >> 16) & 0xFF;
+    buffer[3] = (value >> 24) & 0xFF;
+    return buffer + 4;
+}
+
+bool profiler_serialize(profiler_probe_t probe, uint8_t *buffer) {
+    profiler_stats_t stats;
+    if (!profiler_get_stats(probe, &stats)) {
+        return false;
+    }
+
+    *buffer++ = probe;
+    buffer    = write_u32(buffer, stats.count);
+    buffer    = write_u32(buffer, stats.min_ticks);
+    buffer    = write_u32(buffer, stats.max_ticks);
+    buffer    = write_u32(buffer, stats.avg_ticks);
+    write_u32(buffer, stats.p99_ticks);
+    return true;
+}
+
+bool profiler_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 3 || data[0] != PROFILER_RAW_HID_COMMAND_ID) {
+        return false;
+    }
+
+    uint8_t *command = &data[1];
+    uint8_t *payload = &data[2];
+    switch (*command) {
+        case profiler_raw_hid_get_info:
+            if (length < 7) {
+                *command = profiler_raw_hid_error;
+                break;
+            }
+            payload[0] = PROFILER_PROBE_COUNT;
+            write_u32(&payload[1], profiler_timestamp_frequency());
+            break;
+        case profiler_raw_hid_get_stats:
+            if (length < 2 + PROFILER_RECORD_SIZE || !profiler_serialize(payload[0], payload)) {
+                *command = profiler_raw_hid_error;
+            }
+            break;
+        case profiler_raw_hid_get_name: {
+            const char *name = profiler_get_name(payload[0]);
+            if (name == NULL || length < 4) {
+                *command = profiler_raw_hid_error;
+                break;
+            }
+            strncpy((char *)&payload[1], name, length - 4);
+            data[length - 1] = '\0';
+            break;
+        }
+        case profiler_raw_hid_reset:
+            profiler_reset();
+            break;
+        default:
+            *command = profiler_raw_hid_error;
+            break;
+    }
+    return true;
+}
+
+void profiler_print(void) {
+    uint8_t record[PROFILER_RECORD_SIZE];
+    for (uint8_t probe = 0; probe < PROFILER_PROBE_COUNT; probe++) {
+        profiler_serialize(probe, record);
+        dprint("profiler:");
+        for (uint8_t i = 0; i < sizeof(record); i++) {
+            dprintf("%02X", record[i]);
+        }
+        dprintf(" %s\n", profiler_probe_names[probe]);
+    }
+}
+
+void profiler_task(void) {
+#if PROFILER_CONSOLE_INTERVAL > 0
+    static uint32_t last_print = 0;
+    if (timer_elapsed32(last_print) >= PROFILER_CONSOLE_INTERVAL) {
+        last_print = timer_read32();
+        profiler_print();
+    }
+#endif
+}
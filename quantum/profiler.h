@@ -0,0 +1,215 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @def Number of logarithmic histogram buckets kept per probe. Bucket n counts the durations of n significant bits,
+ * the last bucket also counts everything longer.
+ */
+#ifndef PROFILER_HISTOGRAM_BUCKETS
+#    if defined(__AVR__)
+#        define PROFILER_HISTOGRAM_BUCKETS 16
+#    else
+#        define PROFILER_HISTOGRAM_BUCKETS 24
+#    endif
+#endif
+
+/**
+ * @def Interval in milliseconds at which the statistics of all probes are printed to the console. Zero disables the
+ * periodic output.
+ */
+#ifndef PROFILER_CONSOLE_INTERVAL
+#    define PROFILER_CONSOLE_INTERVAL 0
+#endif
+
+/**
+ * @def First byte of the raw HID packets handled by profiler_raw_hid_receive().
+ */
+#ifndef PROFILER_RAW_HID_COMMAND_ID
+#    define PROFILER_RAW_HID_COMMAND_ID 0xF0
+#endif
+
+#if PROFILER_HISTOGRAM_BUCKETS < 2 || PROFILER_HISTOGRAM_BUCKETS > 33
+#    error "PROFILER_HISTOGRAM_BUCKETS must be between 2 and 33"
+#endif
+
+/**
+ * Probe points, as X(id, name) pairs. Keyboards and keymaps can add their own by defining PROFILER_USER_PROBES in
+ * config.h, for example:
+ *
+ *     #define PROFILER_USER_PROBES(X) X(OLED_RENDER, "oled_render")
+ *
+ * and then wrapping the code to measure in PROFILER_PROBE(OLED_RENDER, ...).
+ */
+#ifndef PROFILER_USER_PROBES
+#    define PROFILER_USER_PROBES(X)
+#endif
+
+#ifdef KEY_OVERRIDE_ENABLE
+#    define PROFILER_KEY_OVERRIDE_PROBES(X) X(PROCESS_KEY_OVERRIDE, "process_key_override")
+#else
+#    define PROFILER_KEY_OVERRIDE_PROBES(X)
+#endif
+#ifdef RGB_MATRIX_ENABLE
+#    define PROFILER_RGB_MATRIX_PROBES(X) X(RGB_MATRIX_TASK, "rgb_matrix_task")
+#else
+#    define PROFILER_RGB_MATRIX_PROBES(X)
+#endif
+#ifdef SPLIT_KEYBOARD
+#    define PROFILER_SPLIT_PROBES(X) X(TRANSACTIONS_MASTER, "transactions_master")
+#else
+#    define PROFILER_SPLIT_PROBES(X)
+#endif
+
+// clang-format off
+#define PROFILER_PROBES(X)                                   \
+    X(MATRIX_SCAN,            "matrix_scan")                 \
+    X(ACTION_EXEC,            "action_exec")                 \
+    X(PROCESS_RECORD_QUANTUM, "process_record_quantum")      \
+    PROFILER_KEY_OVERRIDE_PROBES(X)                          \
+    PROFILER_RGB_MATRIX_PROBES(X)                            \
+    PROFILER_SPLIT_PROBES(X)                                 \
+    X(HOST_KEYBOARD_SEND,     "host_keyboard_send")          \
+    PROFILER_USER_PROBES(X)
+// clang-format on
+
+#define PROFILER_PROBE_ENUM(id, name) PROFILER_PROBE_##id,
+
+/**
+ * @typedef Identifier of a probe point.
+ */
+typedef enum profiler_probe_t {
+    PROFILER_PROBES(PROFILER_PROBE_ENUM) PROFILER_PROBE_COUNT,
+} profiler_probe_t;
+
+#undef PROFILER_PROBE_ENUM
+
+/**
+ * @struct Statistics of a single probe, in timestamp ticks.
+ */
+typedef struct profiler_stats_t {
+    uint32_t count;
+    uint32_t min_ticks;
+    uint32_t max_ticks;
+    uint32_t avg_ticks;
+    uint32_t p99_ticks; // upper bound of the histogram bucket containing the 99th percentile
+} profiler_stats_t;
+
+/**
+ * @def Size in bytes of a probe record written by profiler_serialize().
+ */
+#define PROFILER_RECORD_SIZE 21
+
+/**
+ * @typedef Raw HID requests, sent as [PROFILER_RAW_HID_COMMAND_ID, command, arguments...].
+ *
+ * get_info:  responds with the number of probes in byte 2 and the timestamp frequency in bytes 3-6.
+ * get_stats: takes a probe in byte 2, responds with its record (see profiler_serialize()) from byte 2.
+ * get_name:  takes a probe in byte 2, responds with its NUL terminated name from byte 3.
+ * reset:     clears the statistics of all probes.
+ *
+ * Unknown commands and invalid probes are answered with profiler_raw_hid_error in byte 1.
+ */
+typedef enum profiler_raw_hid_command_t {
+    profiler_raw_hid_get_info  = 0x01,
+    profiler_raw_hid_get_stats = 0x02,
+    profiler_raw_hid_get_name  = 0x03,
+    profiler_raw_hid_reset     = 0x04,
+    profiler_raw_hid_error     = 0xFF,
+} profiler_raw_hid_command_t;
+
+#ifdef PROFILER_ENABLE
+
+/**
+ * Records the duration of the enclosed code under the given probe. The start and end macros must be used in the same
+ * scope, and only once per probe in that scope.
+ */
+#    define PROFILER_PROBE_BEGIN(probe) const uint32_t profiler_start_##probe = profiler_timestamp()
+#    define PROFILER_PROBE_END(probe) profiler_record(PROFILER_PROBE_##probe, profiler_timestamp() - profiler_start_##probe)
+#    define PROFILER_PROBE(probe, call)  \
+        do {                             \
+            PROFILER_PROBE_BEGIN(probe); \
+            call;                        \
+            PROFILER_PROBE_END(probe);   \
+        } while (0)
+
+/**
+ * Returns the current timestamp in ticks, at the highest resolution available on the platform.
+ */
+uint32_t profiler_timestamp(void);
+
+/**
+ * Returns the number of timestamp ticks per second, or zero if unknown.
+ */
+uint32_t profiler_timestamp_frequency(void);
+
+/**
+ * Adds a measurement to the statistics of a probe.
+ *
+ * @param probe[in] the probe
+ * @param ticks[in] the measured duration in timestamp ticks
+ */
+void profiler_record(profiler_probe_t probe, uint32_t ticks);
+
+/**
+ * Retrieves the statistics of a probe.
+ *
+ * @param probe[in] the probe
+ * @param stats[out] the statistics
+ * @return false if the probe does not exist
+ */
+bool profiler_get_stats(profiler_probe_t probe, profiler_stats_t *stats);
+
+/**
+ * Returns the name of a probe, or NULL if the probe does not exist.
+ */
+const char *profiler_get_name(profiler_probe_t probe);
+
+/**
+ * Writes the statistics of a probe as a PROFILER_RECORD_SIZE byte little-endian record: the probe identifier,
+ * followed by the count, minimum, maximum, average and 99th percentile as 32 bit values.
+ *
+ * @param probe[in] the probe
+ * @param buffer[out] the destination, at least PROFILER_RECORD_SIZE bytes
+ * @return false if the probe does not exist
+ */
+bool profiler_serialize(profiler_probe_t probe, uint8_t *buffer);
+
+/**
+ * Clears the statistics of all probes.
+ */
+void profiler_reset(void);
+
+/**
+ * Handles a profiler request received over raw HID, replacing its contents with the response.
+ *
+ * @param data[in,out] the packet, starting with PROFILER_RAW_HID_COMMAND_ID
+ * @param length[in] the size of the packet
+ * @return true if the packet was a profiler request, in which case the caller should send it back
+ */
+bool profiler_raw_hid_receive(uint8_t *data, uint8_t length);
+
+/**
+ * Prints the statistics of all probes to the console.
+ */
+void profiler_print(void);
+
+/**
+ * Periodically prints the statistics if PROFILER_CONSOLE_INTERVAL is set. Should not be invoked by keyboard/user code.
+ */
+void profiler_task(void);
+
+#else
+
+#    define PROFILER_PROBE_BEGIN(probe)
+#    define PROFILER_PROBE_END(probe)
+#    define PROFILER_PROBE(probe, call) \
+        do {                            \
+            call;                       \
+        } while (0)
+
+#endif
@@ -0,0 +1,118 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "profiler.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+class Profiler : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        profiler_reset();
+    }
+};
+
+TEST_F(Profiler, TracksMinMaxAverage) {
+    profiler_record(PROFILER_PROBE_MATRIX_SCAN, 10);
+    profiler_record(PROFILER_PROBE_MATRIX_SCAN, 2);
+    profiler_record(PROFILER_PROBE_MATRIX_SCAN, 30);
+
+    profiler_stats_t stats;
+    ASSERT_TRUE(profiler_get_stats(PROFILER_PROBE_MATRIX_SCAN, &stats));
+    EXPECT_EQ(stats.count, 3);
+    EXPECT_EQ(stats.min_ticks, 2);
+    EXPECT_EQ(stats.max_ticks, 30);
+    EXPECT_EQ(stats.avg_ticks, 14);
+
+    ASSERT_TRUE(profiler_get_stats(PROFILER_PROBE_ACTION_EXEC, &stats));
+    EXPECT_EQ(stats.count, 0);
+    EXPECT_FALSE(profiler_get_stats(PROFILER_PROBE_COUNT, &stats));
+}
+
+TEST_F(Profiler, EstimatesP99FromHistogram) {
+    for (int i = 0; i < 99; i++) {
+        profiler_record(PROFILER_PROBE_ACTION_EXEC, 5);
+    }
+    profiler_record(PROFILER_PROBE_ACTION_EXEC, 100);
+
+    profiler_stats_t stats;
+    profiler_get_stats(PROFILER_PROBE_ACTION_EXEC, &stats);
+    // 5 has three significant bits, so the bucket covers 4-7
+    EXPECT_EQ(stats.p99_ticks, 7);
+
+    profiler_record(PROFILER_PROBE_ACTION_EXEC, 100);
+    profiler_get_stats(PROFILER_PROBE_ACTION_EXEC, &stats);
+    // 100 falls in the last bucket, which is bounded by the maximum
+    EXPECT_EQ(stats.p99_ticks, 100);
+}
+
+TEST_F(Profiler, MeasuresProbedCode) {
+    PROFILER_PROBE(HOST_KEYBOARD_SEND, advance_time(3));
+
+    profiler_stats_t stats;
+    profiler_get_stats(PROFILER_PROBE_HOST_KEYBOARD_SEND, &stats);
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.min_ticks, 3);
+}
+
+TEST_F(Profiler, SerializesLittleEndianRecords) {
+    profiler_record(PROFILER_PROBE_ACTION_EXEC, 0x0102);
+
+    uint8_t record[PROFILER_RECORD_SIZE];
+    ASSERT_TRUE(profiler_serialize(PROFILER_PROBE_ACTION_EXEC, record));
+    const uint8_t expected[PROFILER_RECORD_SIZE] = {
+        PROFILER_PROBE_ACTION_EXEC,
+        0x01, 0x00, 0x00, 0x00, // count
+        0x02, 0x01, 0x00, 0x00, // min
+        0x02, 0x01, 0x00, 0x00, // max
+        0x02, 0x01, 0x00, 0x00, // avg
+        0x02, 0x01, 0x00, 0x00, // p99
+    };
+    EXPECT_EQ(memcmp(record, expected, sizeof(record)), 0);
+}
+
+TEST_F(Profiler, AnswersRawHidRequests) {
+    uint8_t data[32] = {0};
+
+    data[0] = 0x01;
+    EXPECT_FALSE(profiler_raw_hid_receive(data, sizeof(data)));
+
+    data[0] = PROFILER_RAW_HID_COMMAND_ID;
+    data[1] = profiler_raw_hid_get_info;
+    EXPECT_TRUE(profiler_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[1], profiler_raw_hid_get_info);
+    EXPECT_EQ(data[2], PROFILER_PROBE_COUNT);
+    EXPECT_EQ(data[3] | (data[4] << 8), 1000);
+
+    profiler_record(PROFILER_PROBE_MATRIX_SCAN, 7);
+    data[1] = profiler_raw_hid_get_stats;
+    data[2] = PROFILER_PROBE_MATRIX_SCAN;
+    EXPECT_TRUE(profiler_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[1], profiler_raw_hid_get_stats);
+    EXPECT_EQ(data[2], PROFILER_PROBE_MATRIX_SCAN);
+    EXPECT_EQ(data[3], 1);
+    EXPECT_EQ(data[7], 7);
+
+    data[1] = profiler_raw_hid_get_name;
+    data[2] = PROFILER_PROBE_MATRIX_SCAN;
+    EXPECT_TRUE(profiler_raw_hid_receive(data, sizeof(data)));
+    EXPECT_STREQ((const char *)&data[3], "matrix_scan");
+
+    data[1] = profiler_raw_hid_get_stats;
+    data[2] = PROFILER_PROBE_COUNT;
+    EXPECT_TRUE(profiler_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[1], profiler_raw_hid_error);
+
+    data[1] = profiler_raw_hid_reset;
+    EXPECT_TRUE(profiler_raw_hid_receive(data, sizeof(data)));
+    profiler_stats_t stats;
+    profiler_get_stats(PROFILER_PROBE_MATRIX_SCAN, &stats);
+    EXPECT_EQ(stats.count, 0);
+}
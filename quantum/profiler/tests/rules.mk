@@ -0,0 +1,6 @@
+profiler_DEFS := -DPROFILER_ENABLE -DPROFILER_HISTOGRAM_BUCKETS=8
+
+profiler_SRC := \
+    $(QUANTUM_PATH)/profiler/tests/profiler_tests.cpp \
+    $(QUANTUM_PATH)/profiler.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -84,6 +84,10 @@
 #    include "process_layer_lock.h"
 #endif
 
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_async.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -148,6 +152,7 @@ __attribute__((weak)) void unregister_code16(uint16_t code) {
  */
 __attribute__((weak)) void tap_code16_delay(uint16_t code, uint16_t delay) {
     register_code16(code);
+    flush_keyboard_report();
     for (uint16_t i = delay; i > 0; i--) {
         wait_ms(1);
     }
@@ -190,6 +195,8 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+    // The main loop will not run again to send the released keys
+    flush_keyboard_report();
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -210,6 +217,12 @@ void shutdown_quantum(bool jump_to_bootloader) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_MIRROR)
+    dynamic_keymap_flush();
+#endif
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -250,10 +263,10 @@ uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache) {
         } else {
             layer = read_source_layers_cache(event.key);
         }
-        return keymap_key_to_keycode(layer, event.key);
+        return effective_keymap_keycode(layer, event.key);
     } else
 #endif
-        return keymap_key_to_keycode(layer_switch_get_layer(event.key), event.key);
+        return effective_keymap_keycode(layer_switch_get_layer(event.key), event.key);
 }
 
 /* Get keycode, and then process pre tapping functionality */
@@ -571,6 +584,10 @@ void suspend_power_down_quantum(void) {
     pointing_device_task();
 #    endif
 #endif
+#ifdef I2C_ASYNC_ENABLE
+    // The main loop does not run while suspended, complete the transfers that turn off the LEDs and displays
+    i2c_async_flush();
+#endif
 }
 
 __attribute__((weak)) void suspend_wakeup_init_quantum(void) {
@@ -19,6 +19,7 @@ bool ALPHAS_MODS(effect_params_t* params) {
             rgb_matrix_set_color(i, rgb1.r, rgb1.g, rgb1.b);
         }
     }
+    params->is_static = true;
     return rgb_matrix_check_finished_leds(led_max);
 }
 
@@ -15,6 +15,7 @@ bool GRADIENT_LEFT_RIGHT(effect_params_t* params) {
         rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
         rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
     }
+    params->is_static = true;
     return rgb_matrix_check_finished_leds(led_max);
 }
 
@@ -4,20 +4,97 @@
 
 typedef hsv_t (*reactive_splash_f)(hsv_t hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+// Sets the range of distances at which a hit with the given tick is visible, or returns false once it is not visible
+// anywhere anymore. An expired hit must stay expired as its tick grows, as it is removed from the hit buffer.
+typedef bool (*reactive_splash_reach_f)(uint16_t tick, uint8_t* min_dist, uint8_t* max_dist);
+
+#    define REACTIVE_SPLASH_BUCKET_SHIFT 4
+#    define REACTIVE_SPLASH_BUCKETS (256 >> REACTIVE_SPLASH_BUCKET_SHIFT)
+
+#    if LED_HITS_TO_REMEMBER <= 8
+typedef uint8_t reactive_splash_mask_t;
+#    elif LED_HITS_TO_REMEMBER <= 16
+typedef uint16_t reactive_splash_mask_t;
+#    elif LED_HITS_TO_REMEMBER <= 32
+typedef uint32_t reactive_splash_mask_t;
+#    elif LED_HITS_TO_REMEMBER <= 64
+typedef uint64_t reactive_splash_mask_t;
+#    else
+#        error "LED_HITS_TO_REMEMBER must not exceed 64"
+#    endif
+
+// Per frame index of the visible hits. Each bucket covers a band of x or y coordinates and has a bit set for every hit
+// whose reach overlaps it, so an LED only has to consult the hits set in both its column and its row bucket.
+static struct {
+    uint16_t               tick[LED_HITS_TO_REMEMBER];
+    uint8_t                min_dist[LED_HITS_TO_REMEMBER];
+    uint8_t                max_dist[LED_HITS_TO_REMEMBER];
+    reactive_splash_mask_t x_buckets[REACTIVE_SPLASH_BUCKETS];
+    reactive_splash_mask_t y_buckets[REACTIVE_SPLASH_BUCKETS];
+} reactive_splash_index;
+
+static void reactive_splash_mark_buckets(reactive_splash_mask_t* buckets, uint8_t pos, uint8_t reach, reactive_splash_mask_t hit) {
+    uint8_t first = pos > reach ? pos - reach : 0;
+    uint8_t last  = pos < UINT8_MAX - reach ? pos + reach : UINT8_MAX;
+    for (uint8_t b = first >> REACTIVE_SPLASH_BUCKET_SHIFT; b <= last >> REACTIVE_SPLASH_BUCKET_SHIFT; b++) {
+        buckets[b] |= hit;
+    }
+}
+
+static void reactive_splash_build_index(uint8_t start, reactive_splash_reach_f reach_func) {
+    memset(reactive_splash_index.x_buckets, 0, sizeof(reactive_splash_index.x_buckets));
+    memset(reactive_splash_index.y_buckets, 0, sizeof(reactive_splash_index.y_buckets));
+
+    uint16_t expire_tick = UINT16_MAX;
+    bool     expired     = false;
+    for (uint8_t j = 0; j < g_last_hit_tracker.count; j++) {
+        uint16_t tick     = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        uint8_t  min_dist = 0;
+        uint8_t  max_dist = UINT8_MAX;
+        if (reach_func && !reach_func(tick, &min_dist, &max_dist)) {
+            if (g_last_hit_tracker.tick[j] <= expire_tick) {
+                expire_tick = g_last_hit_tracker.tick[j];
+            }
+            expired = true;
+            continue;
+        }
+        if (j < start) continue;
+
+        reactive_splash_index.tick[j]     = tick;
+        reactive_splash_index.min_dist[j] = min_dist;
+        reactive_splash_index.max_dist[j] = max_dist;
+        reactive_splash_mark_buckets(reactive_splash_index.x_buckets, g_last_hit_tracker.x[j], max_dist, (reactive_splash_mask_t)1 << j);
+        reactive_splash_mark_buckets(reactive_splash_index.y_buckets, g_last_hit_tracker.y[j], max_dist, (reactive_splash_mask_t)1 << j);
+    }
+
+    if (expired) {
+        rgb_matrix_expire_hits(expire_tick);
+    }
+}
+
+bool effect_runner_reactive_splash_bounded(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    // The hit tracker only changes between frames
+    if (params->iter == 0 || params->init) {
+        reactive_splash_build_index(start, reach_func);
+    }
+
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         hsv_t hsv = rgb_matrix_config.hsv;
         hsv.v     = 0;
-        for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+
+        uint8_t                x    = g_led_config.point[i].x;
+        uint8_t                y    = g_led_config.point[i].y;
+        reactive_splash_mask_t hits = reactive_splash_index.x_buckets[x >> REACTIVE_SPLASH_BUCKET_SHIFT] & reactive_splash_index.y_buckets[y >> REACTIVE_SPLASH_BUCKET_SHIFT];
+        for (uint8_t j = 0; hits; j++, hits >>= 1) {
+            if (!(hits & 1)) continue;
+            int16_t dx   = x - g_last_hit_tracker.x[j];
+            int16_t dy   = y - g_last_hit_tracker.y[j];
+            uint8_t dist = sqrt16(dx * dx + dy * dy);
+            if (dist < reactive_splash_index.min_dist[j] || dist > reactive_splash_index.max_dist[j]) continue;
+            hsv = effect_func(hsv, dx, dy, dist, reactive_splash_index.tick[j]);
         }
         hsv.v     = scale8(hsv.v, rgb_matrix_config.hsv.v);
         rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
@@ -26,4 +103,8 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_bounded(start, params, effect_func, NULL);
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
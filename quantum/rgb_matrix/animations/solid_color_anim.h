@@ -9,6 +9,7 @@ bool SOLID_COLOR(effect_params_t* params) {
         RGB_MATRIX_TEST_LED_FLAGS();
         rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
     }
+    params->is_static = true;
     return rgb_matrix_check_finished_leds(led_max);
 }
 
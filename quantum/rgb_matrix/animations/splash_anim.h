@@ -19,15 +19,23 @@ hsv_t SPLASH_math(hsv_t hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick
     return hsv;
 }
 
+bool SPLASH_reach(uint16_t tick, uint8_t* min_dist, uint8_t* max_dist) {
+    // Visible while 0 <= tick - dist < 255
+    if (tick > 254 + 255) return false;
+    *min_dist = tick > 254 ? tick - 254 : 0;
+    *max_dist = tick < 255 ? tick : 255;
+    return true;
+}
+
 #            ifdef ENABLE_RGB_MATRIX_SPLASH
 bool SPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(qsub8(g_last_hit_tracker.count, 1), params, &SPLASH_math);
+    return effect_runner_reactive_splash_bounded(qsub8(g_last_hit_tracker.count, 1), params, &SPLASH_math, &SPLASH_reach);
 }
 #            endif
 
 #            ifdef ENABLE_RGB_MATRIX_MULTISPLASH
 bool MULTISPLASH(effect_params_t* params) {
-    return effect_runner_reactive_splash(0, params, &SPLASH_math);
+    return effect_runner_reactive_splash_bounded(0, params, &SPLASH_math, &SPLASH_reach);
 }
 #            endif
 
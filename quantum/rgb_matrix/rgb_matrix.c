@@ -19,6 +19,7 @@
 #include "rgb_matrix.h"
 #include "progmem.h"
 #include "eeprom.h"
+#include "profiler.h"
 #include "eeconfig.h"
 #include "keyboard.h"
 #include "sync_timer.h"
@@ -39,6 +40,39 @@ __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
     return hsv_to_rgb(hsv);
 }
 
+static inline uint8_t rgb_matrix_calc_led_dist(uint8_t i) {
+    int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+    return sqrt16(dx * dx + dy * dy);
+}
+
+static inline uint8_t rgb_matrix_calc_led_angle(uint8_t i) {
+    int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+    return atan2_8(dy, dx);
+}
+
+#if defined(RGB_MATRIX_GEOMETRY_TABLE) && defined(RGB_MATRIX_GEOMETRY_GENERATED)
+// Generated into flash from the info.json layout
+#    define rgb_matrix_led_dist(i) pgm_read_byte(&g_led_geometry[i].dist)
+#    define rgb_matrix_led_angle(i) pgm_read_byte(&g_led_geometry[i].angle)
+#elif defined(RGB_MATRIX_GEOMETRY_TABLE)
+// Calculated once on init, for layouts defined in code
+led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+#    define rgb_matrix_led_dist(i) (g_led_geometry[i].dist)
+#    define rgb_matrix_led_angle(i) (g_led_geometry[i].angle)
+
+static void rgb_matrix_init_geometry(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        g_led_geometry[i].dist  = rgb_matrix_calc_led_dist(i);
+        g_led_geometry[i].angle = rgb_matrix_calc_led_angle(i);
+    }
+}
+#else
+#    define rgb_matrix_led_dist(i) rgb_matrix_calc_led_dist(i)
+#    define rgb_matrix_led_angle(i) rgb_matrix_calc_led_angle(i)
+#endif
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -74,9 +108,19 @@ last_hit_t g_last_hit_tracker;
 static bool            suspend_state     = false;
 static uint8_t         rgb_last_enable   = UINT8_MAX;
 static uint8_t         rgb_last_effect   = UINT8_MAX;
-static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
+static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false, false};
 static rgb_task_states rgb_task_state    = SYNCING;
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+// LEDs painted outside of the effect, by indicators or user code, during the current and the previous frame
+static uint8_t      rgb_overlay_leds[(RGB_MATRIX_LED_COUNT + 7) / 8];
+static uint8_t      rgb_last_overlay_leds[(RGB_MATRIX_LED_COUNT + 7) / 8];
+static rgb_config_t rgb_last_rendered_config;
+static bool         rgb_rendering_effect = false;
+static bool         rgb_render_skipped   = false;
+static bool         rgb_leds_dirty       = true;
+#endif // RGB_MATRIX_DIRTY_TRACKING
+
 // double buffers
 static uint32_t rgb_timer_buffer;
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -153,10 +197,22 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    rgb_leds_dirty = true;
+    if (!rgb_rendering_effect && index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        rgb_overlay_leds[index / 8] |= 1 << (index % 8);
+    }
+#endif // RGB_MATRIX_DIRTY_TRACKING
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    rgb_leds_dirty = true;
+    if (!rgb_rendering_effect) {
+        memset(rgb_overlay_leds, 0xFF, sizeof(rgb_overlay_leds));
+    }
+#endif // RGB_MATRIX_DIRTY_TRACKING
 #if defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
@@ -248,6 +304,24 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+void rgb_matrix_expire_hits(uint16_t tick) {
+    // Hits are stored from oldest to newest, so the expired ones are always at the front
+    uint8_t expired = 0;
+    while (expired < last_hit_buffer.count && last_hit_buffer.tick[expired] >= tick) {
+        expired++;
+    }
+    if (!expired) return;
+
+    uint8_t remaining = last_hit_buffer.count - expired;
+    memmove(&last_hit_buffer.x[0], &last_hit_buffer.x[expired], remaining);
+    memmove(&last_hit_buffer.y[0], &last_hit_buffer.y[expired], remaining);
+    memmove(&last_hit_buffer.tick[0], &last_hit_buffer.tick[expired], remaining * 2); // 16 bit
+    memmove(&last_hit_buffer.index[0], &last_hit_buffer.index[expired], remaining);
+    last_hit_buffer.count = remaining;
+}
+#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+
 static void rgb_task_timers(void) {
 #if defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
     uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
@@ -259,11 +333,12 @@ static void rgb_task_timers(void) {
     uint8_t count = last_hit_buffer.count;
     for (uint8_t i = 0; i < count; ++i) {
         if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
+            last_hit_buffer.tick[i] = UINT16_MAX;
             continue;
         }
         last_hit_buffer.tick[i] += deltaTime;
     }
+    rgb_matrix_expire_hits(UINT16_MAX);
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 }
 
@@ -290,11 +365,35 @@ static void rgb_task_start(void) {
 static void rgb_task_render(uint8_t effect) {
     bool rendering         = false;
     rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    rgb_rendering_effect = true;
+#endif // RGB_MATRIX_DIRTY_TRACKING
     if (rgb_effect_params.flags != rgb_matrix_config.flags) {
         rgb_effect_params.flags = rgb_matrix_config.flags;
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    if (rgb_effect_params.iter == 0) {
+        // A static frame only has to be rendered again once the settings change
+        rgb_render_skipped = rgb_effect_params.is_static && !rgb_effect_params.init && rgb_matrix_config.raw == rgb_last_rendered_config.raw;
+        if (!rgb_render_skipped) {
+            rgb_effect_params.is_static = false;
+            rgb_last_rendered_config    = rgb_matrix_config;
+        }
+    }
+    if (rgb_render_skipped && !rgb_effect_params.init) {
+        // Still step through the LEDs, so the advanced indicators are drawn on all of them
+        RGB_MATRIX_USE_LIMITS_ITER(led_min, led_max, rgb_effect_params.iter);
+        rgb_rendering_effect = false;
+        rgb_effect_params.iter++;
+        if (!rgb_matrix_check_finished_leds(led_max)) {
+            rgb_task_state = FLUSHING;
+        }
+        return;
+    }
+#endif // RGB_MATRIX_DIRTY_TRACKING
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -331,10 +430,16 @@ static void rgb_task_render(uint8_t effect) {
         case UINT8_MAX: {
             rgb_matrix_test();
             rgb_task_state = FLUSHING;
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+            rgb_rendering_effect = false;
+#endif // RGB_MATRIX_DIRTY_TRACKING
         }
             return;
     }
 
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    rgb_rendering_effect = false;
+#endif // RGB_MATRIX_DIRTY_TRACKING
     rgb_effect_params.iter++;
 
     // next task
@@ -348,18 +453,43 @@ static void rgb_task_render(uint8_t effect) {
 }
 
 static void rgb_task_flush(uint8_t effect) {
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    if (rgb_render_skipped && !rgb_effect_params.init) {
+        // LEDs the indicators painted over in the previous frame but not in this one need the effect drawn again
+        for (uint8_t i = 0; i < sizeof(rgb_overlay_leds); i++) {
+            if (rgb_last_overlay_leds[i] & ~rgb_overlay_leds[i]) {
+                rgb_effect_params.is_static = false;
+                rgb_effect_params.iter      = 0;
+                rgb_task_state              = RENDERING;
+                return;
+            }
+        }
+    }
+#endif // RGB_MATRIX_DIRTY_TRACKING
+
     // update last trackers after the first full render so we can init over several frames
     rgb_last_effect = effect;
     rgb_last_enable = rgb_matrix_config.enable;
 
     // update pwm buffers
+#ifdef RGB_MATRIX_DIRTY_TRACKING
+    if (rgb_leds_dirty) {
+        rgb_leds_dirty = false;
+        rgb_matrix_update_pwm_buffers();
+    }
+    memcpy(rgb_last_overlay_leds, rgb_overlay_leds, sizeof(rgb_overlay_leds));
+    memset(rgb_overlay_leds, 0, sizeof(rgb_overlay_leds));
+#else
     rgb_matrix_update_pwm_buffers();
+#endif // RGB_MATRIX_DIRTY_TRACKING
 
     // next task
     rgb_task_state = SYNCING;
 }
 
 void rgb_matrix_task(void) {
+    PROFILER_PROBE_BEGIN(RGB_MATRIX_TASK);
+
     rgb_task_timers();
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
@@ -392,6 +522,8 @@ void rgb_matrix_task(void) {
             rgb_task_sync();
             break;
     }
+
+    PROFILER_PROBE_END(RGB_MATRIX_TASK);
 }
 
 void rgb_matrix_indicators(void) {
@@ -455,6 +587,10 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#if defined(RGB_MATRIX_GEOMETRY_TABLE) && !defined(RGB_MATRIX_GEOMETRY_GENERATED)
+    rgb_matrix_init_geometry();
+#endif
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -24,6 +24,7 @@
 #include "rgb_matrix_drivers.h"
 #include "color.h"
 #include "keyboard.h"
+#include "progmem.h"
 
 #ifndef RGB_MATRIX_TIMEOUT
 #    define RGB_MATRIX_TIMEOUT 0
@@ -274,8 +275,18 @@ extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
+#ifdef RGB_MATRIX_GEOMETRY_TABLE
+#    ifdef RGB_MATRIX_GEOMETRY_GENERATED
+extern const led_geometry_t PROGMEM g_led_geometry[RGB_MATRIX_LED_COUNT];
+#    else
+extern led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+#    endif
+#endif
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
+
+// Removes all hits whose tick has reached the given value from the hit buffer
+void rgb_matrix_expire_hits(uint16_t tick);
 #endif
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
@@ -48,6 +48,7 @@ typedef struct PACKED {
     uint8_t     iter;
     led_flags_t flags;
     bool        init;
+    bool        is_static; // Set by effects whose output only depends on the RGB Matrix settings
 } effect_params_t;
 
 typedef struct PACKED {
@@ -55,6 +56,11 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+typedef struct PACKED {
+    uint8_t dist;  // Distance from k_rgb_matrix_center
+    uint8_t angle; // atan2_8() angle around k_rgb_matrix_center
+} led_geometry_t;
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
@@ -22,6 +22,7 @@
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
+#include "action_util.h"
 #include "wait.h"
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
@@ -146,6 +147,12 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 // Note: we bit-pack in "reverse" order to optimize loading
 #define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
 
+// Staged keyboard reports have to reach the host first, for the delay to take effect
+static void send_string_wait(uint16_t ms) {
+    flush_keyboard_report();
+    wait_ms(ms);
+}
+
 void send_string(const char *string) {
     send_string_with_delay(string, TAP_CODE_DELAY);
 }
@@ -180,10 +187,10 @@ void send_string_with_delay(const char *string, uint8_t interval) {
                     keycode = *(++string);
                 }
 
-                wait_ms(ms);
+                send_string_wait(ms);
             }
 
-            wait_ms(interval);
+            send_string_wait(interval);
         } else {
             send_char_with_delay(ascii_code, interval);
         }
@@ -211,30 +218,30 @@ void send_char_with_delay(char ascii_code, uint8_t interval) {
 
     if (is_shifted) {
         register_code(KC_LEFT_SHIFT);
-        wait_ms(interval);
+        send_string_wait(interval);
     }
 
     if (is_altgred) {
         register_code(KC_RIGHT_ALT);
-        wait_ms(interval);
+        send_string_wait(interval);
     }
 
     tap_code_delay(keycode, interval);
-    wait_ms(interval);
+    send_string_wait(interval);
 
     if (is_altgred) {
         unregister_code(KC_RIGHT_ALT);
-        wait_ms(interval);
+        send_string_wait(interval);
     }
 
     if (is_shifted) {
         unregister_code(KC_LEFT_SHIFT);
-        wait_ms(interval);
+        send_string_wait(interval);
     }
 
     if (is_dead) {
         tap_code(KC_SPACE);
-        wait_ms(interval);
+        send_string_wait(interval);
     }
 }
 
@@ -326,7 +333,7 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
                     ms += keycode - '0';
                     keycode = pgm_read_byte(++string);
                 }
-                wait_ms(ms);
+                send_string_wait(ms);
             }
         } else {
             send_char_with_delay(ascii_code, interval);
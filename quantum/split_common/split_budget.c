@@ -0,0 +1,51 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_budget.h"
+
+static uint16_t split_budget_bytes = 0;
+
+void split_budget_reset(void) {
+    split_budget_bytes = 0;
+}
+
+void split_budget_charge(uint16_t initiator2target_length, uint16_t target2initiator_length) {
+    uint32_t used      = (uint32_t)split_budget_bytes + SPLIT_BUDGET_OVERHEAD + initiator2target_length + target2initiator_length;
+    split_budget_bytes = used < UINT16_MAX ? used : UINT16_MAX;
+}
+
+uint16_t split_budget_used(void) {
+    return split_budget_bytes;
+}
+
+static int16_t split_budget_rank(const uint8_t priorities[], const uint8_t deferred_scans[], uint8_t index) {
+    // Every scan spent waiting moves a handler up by one priority class, so low priority syncs cannot starve
+    return (int16_t)priorities[index] - deferred_scans[index];
+}
+
+int8_t split_budget_next(const uint8_t priorities[], uint8_t deferred_scans[], uint8_t count, uint32_t *done, uint16_t budget) {
+    int8_t next = -1;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (*done & (1UL << i)) continue;
+        if (next < 0 || split_budget_rank(priorities, deferred_scans, i) < split_budget_rank(priorities, deferred_scans, next)) {
+            next = i;
+        }
+    }
+    if (next < 0) {
+        return -1;
+    }
+
+    // At least one handler runs per scan, even if the critical transactions used up the budget
+    if (*done != 0 && split_budget_bytes >= budget) {
+        for (uint8_t i = 0; i < count; ++i) {
+            if (!(*done & (1UL << i)) && deferred_scans[i] < UINT8_MAX) {
+                deferred_scans[i]++;
+            }
+        }
+        return -1;
+    }
+
+    *done |= 1UL << next;
+    deferred_scans[next] = 0;
+    return next;
+}
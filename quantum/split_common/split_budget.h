@@ -0,0 +1,46 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @def Bytes exchanged per transaction on top of its data, its ID and the handshake.
+ */
+#define SPLIT_BUDGET_OVERHEAD 2
+
+/**
+ * Clears the link budget used so far. Called at the start of every scan.
+ */
+void split_budget_reset(void);
+
+/**
+ * Adds an executed transaction to the link budget used in this scan. Every transaction counts, critical ones
+ * included.
+ *
+ * @param initiator2target_length[in] the bytes sent to the slave
+ * @param target2initiator_length[in] the bytes received from the slave
+ */
+void split_budget_charge(uint16_t initiator2target_length, uint16_t target2initiator_length);
+
+/**
+ * Returns the link budget used in this scan, in bytes. Saturates at UINT16_MAX.
+ */
+uint16_t split_budget_used(void);
+
+/**
+ * Picks the next scheduled handler to run. The handler with the lowest priority class minus the scans it has waited
+ * is picked, ties go to the one with the lower index. Once the used budget reaches the limit, no further handler is
+ * picked and every handler left over is marked as having waited one more scan. The first handler of a scan is always
+ * picked, even if the budget is already used up.
+ *
+ * @param priorities[in] the split_transaction_priority_t of each handler
+ * @param deferred_scans[in,out] the scans each handler has waited, cleared for the picked one
+ * @param count[in] the number of handlers, at most 32
+ * @param done[in,out] a mask of the handlers already run in this scan, zero at its start
+ * @param budget[in] the link budget of a scan, in bytes
+ * @return the index of the handler to run, or -1 if all of them ran or the budget is used up
+ */
+int8_t split_budget_next(const uint8_t priorities[], uint8_t deferred_scans[], uint8_t count, uint32_t *done, uint16_t budget);
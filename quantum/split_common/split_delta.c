@@ -0,0 +1,78 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_delta.h"
+
+uint8_t split_delta_encode(const void *data, const void *base, size_t length, uint8_t *output, uint8_t capacity) {
+    const uint8_t *new_data = data;
+    const uint8_t *old_data = base;
+    size_t         pos      = 0;
+    size_t         used     = 0;
+
+    while (pos < length) {
+        uint8_t unchanged = 0;
+        while (pos < length && new_data[pos] == old_data[pos] && unchanged < UINT8_MAX) {
+            unchanged++;
+            pos++;
+        }
+
+        size_t  start   = pos;
+        uint8_t changed = 0;
+        while (pos < length && new_data[pos] != old_data[pos] && changed < UINT8_MAX) {
+            changed++;
+            pos++;
+        }
+
+        if (changed == 0 && pos == length) {
+            break;
+        }
+        if (used + 2 + changed > capacity) {
+            return 0;
+        }
+
+        output[used++] = unchanged;
+        output[used++] = changed;
+        for (uint8_t i = 0; i < changed; i++) {
+            output[used++] = new_data[start + i] ^ old_data[start + i];
+        }
+    }
+    return used;
+}
+
+bool split_delta_apply(void *target, size_t length, const uint8_t *delta, uint8_t delta_length) {
+    uint8_t *buffer = target;
+
+    // The first pass only validates, so that a malformed difference is not partially applied
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        size_t  pos = 0;
+        uint8_t i   = 0;
+        while (i < delta_length) {
+            if (delta_length - i < 2) {
+                return false;
+            }
+            uint8_t unchanged = delta[i++];
+            uint8_t changed   = delta[i++];
+            if (delta_length - i < changed || pos + unchanged + changed > length) {
+                return false;
+            }
+
+            pos += unchanged;
+            if (pass == 1) {
+                for (uint8_t j = 0; j < changed; j++) {
+                    buffer[pos + j] ^= delta[i + j];
+                }
+            }
+            pos += changed;
+            i += changed;
+        }
+    }
+    return true;
+}
+
+void split_delta_full_write(split_delta_state_t *state, bool okay) {
+    state->stale = !okay;
+}
+
+bool split_delta_base_valid(const split_delta_state_t *state) {
+    return !state->stale;
+}
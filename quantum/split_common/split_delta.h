@@ -0,0 +1,56 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Encodes the difference between two buffers of the same length as runs of [unchanged byte count, changed byte count,
+ * changed bytes XOR base]. Unchanged bytes at the end are not encoded.
+ *
+ * @param data[in] the new contents
+ * @param base[in] the contents the receiver already has
+ * @param length[in] the size of both buffers
+ * @param output[out] the encoded difference
+ * @param capacity[in] the size of the output buffer
+ * @return the encoded length, or 0 if the buffers are identical or the difference does not fit
+ */
+uint8_t split_delta_encode(const void *data, const void *base, size_t length, uint8_t *output, uint8_t capacity);
+
+/**
+ * Applies a difference produced by split_delta_encode(). The target is left untouched if the difference is malformed
+ * or does not fit.
+ *
+ * @param target[in,out] the buffer holding the base contents
+ * @param length[in] the size of the target
+ * @param delta[in] the encoded difference
+ * @param delta_length[in] the size of the encoded difference
+ * @return false if the difference was rejected
+ */
+bool split_delta_apply(void *target, size_t length, const uint8_t *delta, uint8_t delta_length);
+
+/**
+ * Master side state of a region that is synced with differences.
+ */
+typedef struct {
+    uint8_t sequence; // The sequence number the slave is expected to be at
+    bool    stale;    // Set while the base may hold contents the slave never received
+} split_delta_state_t;
+
+/**
+ * Records the outcome of a full write of a region. A failed write may have updated the base without reaching the
+ * slave, so no difference is sent against it until a full write succeeds.
+ *
+ * @param state[in,out] the state of the region
+ * @param okay[in] whether the full write succeeded
+ */
+void split_delta_full_write(split_delta_state_t *state, bool okay);
+
+/**
+ * @param state[in] the state of the region
+ * @return whether the base holds what the slave has, so that a difference against it can be sent
+ */
+bool split_delta_base_valid(const split_delta_state_t *state);
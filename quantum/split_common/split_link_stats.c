@@ -0,0 +1,202 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "split_link_stats.h"
+#include "transaction_id_define.h"
+#include "timer.h"
+#include "keyboard.h"
+
+#ifdef PROFILER_ENABLE
+#    include "profiler.h"
+#endif
+
+typedef struct {
+    uint32_t successes;
+    uint32_t failures;
+    uint32_t retries;
+    uint32_t min_ticks;
+    uint32_t max_ticks;
+    uint64_t total_ticks;
+    uint32_t bytes;
+    bool     last_failed;
+} split_link_stats_state_t;
+
+static split_link_stats_state_t split_link_stats[NUM_TOTAL_TRANSACTIONS];
+static split_link_stats_t       split_link_stats_total;
+
+//------------------------------------
+// Recording
+//
+
+uint32_t split_link_stats_timestamp(void) {
+#ifdef PROFILER_ENABLE
+    return profiler_timestamp();
+#else
+    return timer_read32();
+#endif
+}
+
+static uint32_t split_link_stats_frequency(void) {
+#ifdef PROFILER_ENABLE
+    return profiler_timestamp_frequency();
+#else
+    return 1000;
+#endif
+}
+
+static uint32_t ticks_to_us(uint64_t ticks) {
+    uint32_t frequency = split_link_stats_frequency();
+    if (frequency == 0) {
+        return 0;
+    }
+    uint64_t us = ticks * 1000000 / frequency;
+    return us > UINT32_MAX ? UINT32_MAX : us;
+}
+
+void split_link_stats_record(int8_t transaction_id, bool success, uint32_t start, uint16_t bytes) {
+    if (transaction_id < 0 || transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        return;
+    }
+
+    uint32_t                  ticks = split_link_stats_timestamp() - start;
+    split_link_stats_state_t *state = &split_link_stats[transaction_id];
+
+    if (state->last_failed && state->retries < UINT32_MAX) {
+        state->retries++;
+    }
+    state->last_failed = !success;
+    if (state->bytes <= UINT32_MAX - bytes) {
+        state->bytes += bytes;
+    }
+
+    if (!success) {
+        if (state->failures < UINT32_MAX) {
+            state->failures++;
+        }
+        return;
+    }
+    if (state->successes == UINT32_MAX) {
+        return;
+    }
+    if (state->successes == 0 || ticks < state->min_ticks) {
+        state->min_ticks = ticks;
+    }
+    if (ticks > state->max_ticks) {
+        state->max_ticks = ticks;
+    }
+    state->total_ticks += ticks;
+    state->successes++;
+}
+
+void split_link_stats_reset(void) {
+    memset(split_link_stats, 0, sizeof(split_link_stats));
+    memset(&split_link_stats_total, 0, sizeof(split_link_stats_total));
+}
+
+//------------------------------------
+// Reporting
+//
+
+bool split_link_stats_get(int8_t transaction_id, split_link_stats_t *stats) {
+    if (transaction_id < 0 || transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        return false;
+    }
+
+    const split_link_stats_state_t *state = &split_link_stats[transaction_id];
+
+    stats->successes  = state->successes;
+    stats->failures   = state->failures;
+    stats->retries    = state->retries;
+    stats->min_rtt_us = ticks_to_us(state->min_ticks);
+    stats->max_rtt_us = ticks_to_us(state->max_ticks);
+    stats->avg_rtt_us = state->successes ? ticks_to_us(state->total_ticks / state->successes) : 0;
+    stats->bytes      = state->bytes;
+    return true;
+}
+
+void split_link_stats_get_total(split_link_stats_t *stats) {
+    if (!is_keyboard_master()) {
+        *stats = split_link_stats_total;
+        return;
+    }
+
+    uint32_t min_ticks   = 0;
+    uint32_t max_ticks   = 0;
+    uint64_t total_ticks = 0;
+    memset(stats, 0, sizeof(split_link_stats_t));
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        const split_link_stats_state_t *state = &split_link_stats[id];
+        if (state->successes) {
+            if (stats->successes == 0 || state->min_ticks < min_ticks) {
+                min_ticks = state->min_ticks;
+            }
+            if (state->max_ticks > max_ticks) {
+                max_ticks = state->max_ticks;
+            }
+        }
+        stats->successes += state->successes;
+        stats->failures += state->failures;
+        stats->retries += state->retries;
+        stats->bytes += state->bytes;
+        total_ticks += state->total_ticks;
+    }
+    stats->min_rtt_us = ticks_to_us(min_ticks);
+    stats->max_rtt_us = ticks_to_us(max_ticks);
+    stats->avg_rtt_us = stats->successes ? ticks_to_us(total_ticks / stats->successes) : 0;
+}
+
+void split_link_stats_set_total(const split_link_stats_t *stats) {
+    split_link_stats_total = *stats;
+}
+
+static uint8_t *write_u32(uint8_t *buffer, uint32_t value) {
+    buffer[0] = value & 0xFF;
+    buffer[1] = (value >> 8) & 0xFF;
+    buffer[2] = (value >> 16) & 0xFF;
+    buffer[3] = (value >> 24) & 0xFF;
+    return buffer + 4;
+}
+
+bool split_link_stats_serialize(int8_t transaction_id, uint8_t *buffer) {
+    split_link_stats_t stats;
+    if (!split_link_stats_get(transaction_id, &stats)) {
+        return false;
+    }
+
+    *buffer++ = transaction_id;
+    buffer    = write_u32(buffer, stats.successes);
+    buffer    = write_u32(buffer, stats.failures);
+    buffer    = write_u32(buffer, stats.retries);
+    buffer    = write_u32(buffer, stats.min_rtt_us);
+    buffer    = write_u32(buffer, stats.max_rtt_us);
+    buffer    = write_u32(buffer, stats.avg_rtt_us);
+    write_u32(buffer, stats.bytes);
+    return true;
+}
+
+bool split_link_stats_raw_hid_receive(uint8_t *data, uint8_t length) {
+    if (length < 3 || data[0] != SPLIT_LINK_STATS_RAW_HID_COMMAND_ID) {
+        return false;
+    }
+
+    uint8_t *command = &data[1];
+    uint8_t *payload = &data[2];
+    switch (*command) {
+        case split_link_stats_raw_hid_get_info:
+            payload[0] = NUM_TOTAL_TRANSACTIONS;
+            break;
+        case split_link_stats_raw_hid_get_stats:
+            if (length < 2 + SPLIT_LINK_STATS_RECORD_SIZE || !split_link_stats_serialize(payload[0], payload)) {
+                *command = split_link_stats_raw_hid_error;
+            }
+            break;
+        case split_link_stats_raw_hid_reset:
+            split_link_stats_reset();
+            break;
+        default:
+            *command = split_link_stats_raw_hid_error;
+            break;
+    }
+    return true;
+}
@@ -0,0 +1,108 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @def First byte of the raw HID packets handled by split_link_stats_raw_hid_receive().
+ */
+#ifndef SPLIT_LINK_STATS_RAW_HID_COMMAND_ID
+#    define SPLIT_LINK_STATS_RAW_HID_COMMAND_ID 0xF1
+#endif
+
+/**
+ * @struct Statistics of the transactions executed under one transaction ID. Round trip times only cover successful
+ * transactions.
+ */
+typedef struct split_link_stats_t {
+    uint32_t successes;
+    uint32_t failures;
+    uint32_t retries; // attempts following a failure of the same transaction
+    uint32_t min_rtt_us;
+    uint32_t max_rtt_us;
+    uint32_t avg_rtt_us;
+    uint32_t bytes; // payload bytes in both directions
+} split_link_stats_t;
+
+/**
+ * @def Size in bytes of a record written by split_link_stats_serialize().
+ */
+#define SPLIT_LINK_STATS_RECORD_SIZE 29
+
+/**
+ * @typedef Raw HID requests, sent as [SPLIT_LINK_STATS_RAW_HID_COMMAND_ID, command, arguments...].
+ *
+ * get_info:  responds with the number of transaction IDs in byte 2.
+ * get_stats: takes a transaction ID in byte 2, responds with its record (see split_link_stats_serialize()) from byte 2.
+ * reset:     clears the statistics of all transactions.
+ *
+ * Unknown commands and invalid transaction IDs are answered with split_link_stats_raw_hid_error in byte 1.
+ */
+typedef enum split_link_stats_raw_hid_command_t {
+    split_link_stats_raw_hid_get_info  = 0x01,
+    split_link_stats_raw_hid_get_stats = 0x02,
+    split_link_stats_raw_hid_reset     = 0x03,
+    split_link_stats_raw_hid_error     = 0xFF,
+} split_link_stats_raw_hid_command_t;
+
+/**
+ * Returns the timestamp to pass to split_link_stats_record(). The profiler timestamps are used when it is enabled,
+ * milliseconds otherwise.
+ */
+uint32_t split_link_stats_timestamp(void);
+
+/**
+ * Adds an executed transaction to the statistics.
+ *
+ * @param transaction_id[in] the transaction
+ * @param success[in] whether the transaction succeeded
+ * @param start[in] the timestamp taken before the transaction was started
+ * @param bytes[in] the payload bytes in both directions
+ */
+void split_link_stats_record(int8_t transaction_id, bool success, uint32_t start, uint16_t bytes);
+
+/**
+ * Retrieves the statistics of a transaction.
+ *
+ * @param transaction_id[in] the transaction
+ * @param stats[out] the statistics
+ * @return false if the transaction does not exist
+ */
+bool split_link_stats_get(int8_t transaction_id, split_link_stats_t *stats);
+
+/**
+ * Retrieves the statistics of all transactions combined. On the slave these are the ones last synced from the master.
+ */
+void split_link_stats_get_total(split_link_stats_t *stats);
+
+/**
+ * Stores the combined statistics received from the master. Should not be invoked by keyboard/user code.
+ */
+void split_link_stats_set_total(const split_link_stats_t *stats);
+
+/**
+ * Writes the statistics of a transaction as a SPLIT_LINK_STATS_RECORD_SIZE byte little-endian record: the transaction
+ * ID, followed by the fields of split_link_stats_t as 32 bit values.
+ *
+ * @param transaction_id[in] the transaction
+ * @param buffer[out] the destination, at least SPLIT_LINK_STATS_RECORD_SIZE bytes
+ * @return false if the transaction does not exist
+ */
+bool split_link_stats_serialize(int8_t transaction_id, uint8_t *buffer);
+
+/**
+ * Clears the statistics of all transactions.
+ */
+void split_link_stats_reset(void);
+
+/**
+ * Handles a link statistics request received over raw HID, replacing its contents with the response.
+ *
+ * @param data[in,out] the packet, starting with SPLIT_LINK_STATS_RAW_HID_COMMAND_ID
+ * @param length[in] the size of the packet
+ * @return true if the packet was a link statistics request, in which case the caller should send it back
+ */
+bool split_link_stats_raw_hid_receive(uint8_t *data, uint8_t length);
@@ -18,6 +18,7 @@
 #include "keyboard.h"
 #include "timer.h"
 #include "transport.h"
+#include "transactions.h"
 #include "wait.h"
 #include "debug.h"
 #include "usb_util.h"
@@ -203,6 +204,10 @@ void split_pre_init(void) {
 
     isLeftHand = is_keyboard_left(); // TODO: Remove isLeftHand
 
+#ifdef SPLIT_MATRIX_NOTIFY_PIN
+    split_matrix_notify_init();
+#endif
+
 #if defined(RGBLIGHT_ENABLE) && defined(RGBLED_SPLIT)
     uint8_t num_rgb_leds_split[2] = RGBLED_SPLIT;
     if (is_keyboard_left()) {
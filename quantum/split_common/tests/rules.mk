@@ -0,0 +1,20 @@
+split_delta_INC := $(QUANTUM_PATH)/split_common
+
+split_delta_SRC := \
+    $(QUANTUM_PATH)/split_common/tests/split_delta_tests.cpp \
+    $(QUANTUM_PATH)/split_common/split_delta.c
+
+split_link_stats_DEFS := -DSPLIT_KEYBOARD
+
+split_link_stats_INC := $(QUANTUM_PATH)/split_common
+
+split_link_stats_SRC := \
+    $(QUANTUM_PATH)/split_common/tests/split_link_stats_tests.cpp \
+    $(QUANTUM_PATH)/split_common/split_link_stats.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+split_budget_INC := $(QUANTUM_PATH)/split_common
+
+split_budget_SRC := \
+    $(QUANTUM_PATH)/split_common/tests/split_budget_tests.cpp \
+    $(QUANTUM_PATH)/split_common/split_budget.c
@@ -0,0 +1,114 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "split_budget.h"
+}
+
+// Same values as split_transaction_priority_t
+enum { CRITICAL, NORMAL, LOW };
+
+class SplitBudget : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        split_budget_reset();
+    }
+};
+
+TEST_F(SplitBudget, EveryTransactionIsCharged) {
+    EXPECT_EQ(split_budget_used(), 0);
+    split_budget_charge(4, 0);
+    split_budget_charge(0, 1);
+    EXPECT_EQ(split_budget_used(), 4 + 1 + 2 * SPLIT_BUDGET_OVERHEAD);
+    split_budget_reset();
+    EXPECT_EQ(split_budget_used(), 0);
+}
+
+TEST_F(SplitBudget, ChargeSaturates) {
+    split_budget_charge(UINT16_MAX, UINT16_MAX);
+    split_budget_charge(1, 1);
+    EXPECT_EQ(split_budget_used(), UINT16_MAX);
+}
+
+TEST_F(SplitBudget, RunsAllInPriorityOrderWithinBudget) {
+    const uint8_t priorities[] = {LOW, NORMAL, LOW, NORMAL};
+    uint8_t       deferred[4]  = {0};
+    uint32_t      done         = 0;
+
+    EXPECT_EQ(split_budget_next(priorities, deferred, 4, &done, 100), 1);
+    EXPECT_EQ(split_budget_next(priorities, deferred, 4, &done, 100), 3);
+    EXPECT_EQ(split_budget_next(priorities, deferred, 4, &done, 100), 0);
+    EXPECT_EQ(split_budget_next(priorities, deferred, 4, &done, 100), 2);
+    EXPECT_EQ(split_budget_next(priorities, deferred, 4, &done, 100), -1);
+    EXPECT_EQ(done, 0xFUL);
+}
+
+TEST_F(SplitBudget, StopsOnceBudgetIsUsedUp) {
+    const uint8_t priorities[] = {NORMAL, LOW, LOW};
+    uint8_t       deferred[3]  = {0};
+    uint32_t      done         = 0;
+
+    EXPECT_EQ(split_budget_next(priorities, deferred, 3, &done, 10), 0);
+    split_budget_charge(8, 0);
+    EXPECT_EQ(split_budget_next(priorities, deferred, 3, &done, 10), -1);
+    EXPECT_EQ(deferred[0], 0);
+    EXPECT_EQ(deferred[1], 1);
+    EXPECT_EQ(deferred[2], 1);
+}
+
+TEST_F(SplitBudget, CriticalTransactionsCountTowardsBudget) {
+    const uint8_t priorities[] = {NORMAL, NORMAL};
+    uint8_t       deferred[2]  = {0};
+    uint32_t      done         = 0;
+
+    // The critical syncs run before the schedule, but are charged all the same
+    split_budget_charge(2, 6);
+    split_budget_charge(0, 4);
+    ASSERT_GE(split_budget_used(), 10);
+
+    // One handler still runs per scan
+    EXPECT_EQ(split_budget_next(priorities, deferred, 2, &done, 10), 0);
+    EXPECT_EQ(split_budget_next(priorities, deferred, 2, &done, 10), -1);
+    EXPECT_EQ(deferred[1], 1);
+}
+
+TEST_F(SplitBudget, WaitingRaisesPriority) {
+    const uint8_t priorities[] = {NORMAL, LOW};
+    uint8_t       deferred[2]  = {0};
+
+    // Scan 1: the normal handler uses up the budget, the low one waits
+    uint32_t done = 0;
+    EXPECT_EQ(split_budget_next(priorities, deferred, 2, &done, 4), 0);
+    split_budget_charge(2, 0);
+    EXPECT_EQ(split_budget_next(priorities, deferred, 2, &done, 4), -1);
+    EXPECT_EQ(deferred[1], 1);
+
+    // Scan 2: both rank the same now, the normal handler still wins the tie
+    split_budget_reset();
+    done = 0;
+    EXPECT_EQ(split_budget_next(priorities, deferred, 2, &done, 4), 0);
+    split_budget_charge(2, 0);
+    EXPECT_EQ(split_budget_next(priorities, deferred, 2, &done, 4), -1);
+    EXPECT_EQ(deferred[1], 2);
+
+    // Scan 3: the low handler has waited long enough to go first
+    split_budget_reset();
+    done = 0;
+    EXPECT_EQ(split_budget_next(priorities, deferred, 2, &done, 4), 1);
+    EXPECT_EQ(deferred[1], 0);
+    split_budget_charge(2, 0);
+    EXPECT_EQ(split_budget_next(priorities, deferred, 2, &done, 4), -1);
+    EXPECT_EQ(deferred[0], 1);
+}
+
+TEST_F(SplitBudget, DeferredScansSaturate) {
+    const uint8_t priorities[] = {NORMAL, LOW};
+    uint8_t       deferred[2]  = {0, UINT8_MAX};
+    uint32_t      done         = 1;
+
+    split_budget_charge(10, 10);
+    EXPECT_EQ(split_budget_next(priorities, deferred, 2, &done, 4), -1);
+    EXPECT_EQ(deferred[1], UINT8_MAX);
+}
@@ -0,0 +1,109 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "split_delta.h"
+}
+
+class SplitDelta : public ::testing::Test {};
+
+TEST_F(SplitDelta, IdenticalBuffersEncodeToNothing) {
+    uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t output[16];
+    EXPECT_EQ(split_delta_encode(data, data, sizeof(data), output, sizeof(output)), 0);
+}
+
+TEST_F(SplitDelta, SingleChangeIsCompact) {
+    uint8_t base[64] = {0};
+    uint8_t data[64] = {0};
+    data[40]         = 0x5A;
+
+    uint8_t output[16];
+    uint8_t length = split_delta_encode(data, base, sizeof(data), output, sizeof(output));
+    ASSERT_EQ(length, 3);
+    EXPECT_EQ(output[0], 40);
+    EXPECT_EQ(output[1], 1);
+    EXPECT_EQ(output[2], 0x5A);
+
+    ASSERT_TRUE(split_delta_apply(base, sizeof(base), output, length));
+    EXPECT_EQ(memcmp(base, data, sizeof(data)), 0);
+}
+
+TEST_F(SplitDelta, RoundTripsScatteredChanges) {
+    uint8_t base[300];
+    uint8_t data[300];
+    for (size_t i = 0; i < sizeof(base); i++) {
+        base[i] = i * 7;
+        data[i] = base[i];
+    }
+    data[0] ^= 0xFF;
+    data[1] ^= 0x01;
+    data[150] ^= 0x10;
+    data[299] ^= 0x80;
+
+    uint8_t output[32];
+    uint8_t length = split_delta_encode(data, base, sizeof(data), output, sizeof(output));
+    ASSERT_GT(length, 0);
+    ASSERT_TRUE(split_delta_apply(base, sizeof(base), output, length));
+    EXPECT_EQ(memcmp(base, data, sizeof(data)), 0);
+}
+
+TEST_F(SplitDelta, RejectsDeltaThatDoesNotFit) {
+    uint8_t base[32] = {0};
+    uint8_t data[32];
+    memset(data, 0xAA, sizeof(data));
+
+    uint8_t output[16];
+    EXPECT_EQ(split_delta_encode(data, base, sizeof(data), output, sizeof(output)), 0);
+}
+
+TEST_F(SplitDelta, MalformedDeltaLeavesTargetUntouched) {
+    uint8_t target[4]   = {1, 2, 3, 4};
+    uint8_t expected[4] = {1, 2, 3, 4};
+
+    // The first run is valid, the second one reaches past the end of the target
+    uint8_t past_end[] = {0, 1, 0xFF, 2, 2, 0xFF, 0xFF};
+    EXPECT_FALSE(split_delta_apply(target, sizeof(target), past_end, sizeof(past_end)));
+    EXPECT_EQ(memcmp(target, expected, sizeof(target)), 0);
+
+    uint8_t truncated[] = {0, 3, 0xFF};
+    EXPECT_FALSE(split_delta_apply(target, sizeof(target), truncated, sizeof(truncated)));
+    EXPECT_EQ(memcmp(target, expected, sizeof(target)), 0);
+}
+
+TEST_F(SplitDelta, FailedFullWriteSuspendsDifferences) {
+    split_delta_state_t state    = {0};
+    uint8_t             base[8]  = {0}; // The master's transaction buffer
+    uint8_t             slave[8] = {0}; // What the slave has
+    uint8_t             data[8]  = {0};
+    uint8_t             output[16];
+
+    // The full write updates the base, but never reaches the slave
+    data[0] = 1;
+    memcpy(base, data, sizeof(data));
+    split_delta_full_write(&state, false);
+
+    // A difference against the base would leave the slave without the first change
+    data[1]        = 2;
+    uint8_t length = split_delta_encode(data, base, sizeof(data), output, sizeof(output));
+    uint8_t stale[8];
+    memcpy(stale, slave, sizeof(slave));
+    ASSERT_TRUE(split_delta_apply(stale, sizeof(stale), output, length));
+    EXPECT_NE(memcmp(stale, data, sizeof(data)), 0);
+    EXPECT_FALSE(split_delta_base_valid(&state));
+
+    // So the change is sent in full instead
+    memcpy(base, data, sizeof(data));
+    memcpy(slave, data, sizeof(data));
+    split_delta_full_write(&state, true);
+    ASSERT_TRUE(split_delta_base_valid(&state));
+
+    // After which differences apply again
+    data[2] = 3;
+    length  = split_delta_encode(data, base, sizeof(data), output, sizeof(output));
+    ASSERT_GT(length, 0);
+    ASSERT_TRUE(split_delta_apply(slave, sizeof(slave), output, length));
+    EXPECT_EQ(memcmp(slave, data, sizeof(data)), 0);
+}
@@ -0,0 +1,134 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "split_link_stats.h"
+// The transaction IDs are checked with the C11 keyword
+#define _Static_assert static_assert
+#include "transaction_id_define.h"
+#undef _Static_assert
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+
+static bool keyboard_master = true;
+
+bool is_keyboard_master(void) {
+    return keyboard_master;
+}
+}
+
+class SplitLinkStats : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        keyboard_master = true;
+        set_time(0);
+        split_link_stats_reset();
+    }
+
+    void transaction(int8_t id, bool success, uint32_t duration_ms, uint16_t bytes) {
+        uint32_t start = split_link_stats_timestamp();
+        advance_time(duration_ms);
+        split_link_stats_record(id, success, start, bytes);
+    }
+};
+
+TEST_F(SplitLinkStats, RecordsRoundTripTimes) {
+    transaction(GET_SLAVE_MATRIX_CHECKSUM, true, 2, 1);
+    transaction(GET_SLAVE_MATRIX_CHECKSUM, true, 4, 1);
+    transaction(GET_SLAVE_MATRIX_CHECKSUM, true, 9, 1);
+
+    split_link_stats_t stats;
+    ASSERT_TRUE(split_link_stats_get(GET_SLAVE_MATRIX_CHECKSUM, &stats));
+    EXPECT_EQ(stats.successes, 3);
+    EXPECT_EQ(stats.failures, 0);
+    EXPECT_EQ(stats.retries, 0);
+    EXPECT_EQ(stats.min_rtt_us, 2000);
+    EXPECT_EQ(stats.max_rtt_us, 9000);
+    EXPECT_EQ(stats.avg_rtt_us, 5000);
+    EXPECT_EQ(stats.bytes, 3);
+}
+
+TEST_F(SplitLinkStats, CountsFailuresAndRetries) {
+    transaction(GET_SLAVE_MATRIX_DATA, false, 100, 8);
+    transaction(GET_SLAVE_MATRIX_DATA, false, 100, 8);
+    transaction(GET_SLAVE_MATRIX_DATA, true, 1, 8);
+    transaction(GET_SLAVE_MATRIX_DATA, true, 1, 8);
+
+    split_link_stats_t stats;
+    ASSERT_TRUE(split_link_stats_get(GET_SLAVE_MATRIX_DATA, &stats));
+    EXPECT_EQ(stats.successes, 2);
+    EXPECT_EQ(stats.failures, 2);
+    EXPECT_EQ(stats.retries, 2);
+    EXPECT_EQ(stats.max_rtt_us, 1000);
+    EXPECT_EQ(stats.bytes, 32);
+}
+
+TEST_F(SplitLinkStats, CombinesTransactions) {
+    transaction(GET_SLAVE_MATRIX_CHECKSUM, true, 1, 1);
+    transaction(GET_SLAVE_MATRIX_DATA, false, 5, 8);
+    transaction(GET_SLAVE_MATRIX_DATA, true, 3, 8);
+
+    split_link_stats_t total;
+    split_link_stats_get_total(&total);
+    EXPECT_EQ(total.successes, 2);
+    EXPECT_EQ(total.failures, 1);
+    EXPECT_EQ(total.retries, 1);
+    EXPECT_EQ(total.min_rtt_us, 1000);
+    EXPECT_EQ(total.max_rtt_us, 3000);
+    EXPECT_EQ(total.avg_rtt_us, 2000);
+    EXPECT_EQ(total.bytes, 17);
+}
+
+TEST_F(SplitLinkStats, SlaveReportsSyncedTotal) {
+    transaction(GET_SLAVE_MATRIX_CHECKSUM, true, 1, 1);
+    split_link_stats_t total;
+    split_link_stats_get_total(&total);
+
+    keyboard_master = false;
+    split_link_stats_reset();
+    split_link_stats_set_total(&total);
+
+    split_link_stats_t synced;
+    split_link_stats_get_total(&synced);
+    EXPECT_EQ(memcmp(&synced, &total, sizeof(total)), 0);
+}
+
+TEST_F(SplitLinkStats, RejectsInvalidTransactions) {
+    transaction(-1, true, 1, 1);
+    transaction(NUM_TOTAL_TRANSACTIONS, true, 1, 1);
+
+    split_link_stats_t stats;
+    EXPECT_FALSE(split_link_stats_get(-1, &stats));
+    EXPECT_FALSE(split_link_stats_get(NUM_TOTAL_TRANSACTIONS, &stats));
+    split_link_stats_get_total(&stats);
+    EXPECT_EQ(stats.successes, 0);
+}
+
+TEST_F(SplitLinkStats, AnswersRawHidRequests) {
+    transaction(GET_SLAVE_MATRIX_DATA, true, 2, 0x1234);
+
+    uint8_t data[32] = {SPLIT_LINK_STATS_RAW_HID_COMMAND_ID, split_link_stats_raw_hid_get_info};
+    ASSERT_TRUE(split_link_stats_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[1], split_link_stats_raw_hid_get_info);
+    EXPECT_EQ(data[2], NUM_TOTAL_TRANSACTIONS);
+
+    uint8_t request[32] = {SPLIT_LINK_STATS_RAW_HID_COMMAND_ID, split_link_stats_raw_hid_get_stats, GET_SLAVE_MATRIX_DATA};
+    ASSERT_TRUE(split_link_stats_raw_hid_receive(request, sizeof(request)));
+    EXPECT_EQ(request[1], split_link_stats_raw_hid_get_stats);
+    EXPECT_EQ(request[2], GET_SLAVE_MATRIX_DATA);
+    EXPECT_EQ(request[3], 1);               // successes
+    EXPECT_EQ(request[15], 2000 & 0xFF);    // min_rtt_us
+    EXPECT_EQ(request[16], 2000 >> 8);      // min_rtt_us
+    EXPECT_EQ(request[27], 0x34);           // bytes
+    EXPECT_EQ(request[28], 0x12);           // bytes
+
+    uint8_t invalid[32] = {SPLIT_LINK_STATS_RAW_HID_COMMAND_ID, split_link_stats_raw_hid_get_stats, NUM_TOTAL_TRANSACTIONS};
+    ASSERT_TRUE(split_link_stats_raw_hid_receive(invalid, sizeof(invalid)));
+    EXPECT_EQ(invalid[1], split_link_stats_raw_hid_error);
+
+    uint8_t other[32] = {0x01, split_link_stats_raw_hid_get_info};
+    EXPECT_FALSE(split_link_stats_raw_hid_receive(other, sizeof(other)));
+}
@@ -0,0 +1,3 @@
+TEST_LIST += split_delta
+TEST_LIST += split_link_stats
+TEST_LIST += split_budget
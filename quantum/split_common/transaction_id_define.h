@@ -97,6 +97,18 @@ enum serial_transaction_id {
     PUT_ACTIVITY,
 #endif // SPLIT_ACTIVITY_ENABLE
 
+#ifdef SPLIT_LINK_STATS_ENABLE
+    PUT_LINK_STATS,
+#endif // SPLIT_LINK_STATS_ENABLE
+
+#ifdef SPLIT_TRANSACTION_DELTA
+    PUT_DELTA,
+#endif // SPLIT_TRANSACTION_DELTA
+
+#ifdef SPLIT_TRANSACTION_BUNDLE
+    EXECUTE_BUNDLE,
+#endif // SPLIT_TRANSACTION_BUNDLE
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
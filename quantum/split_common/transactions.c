@@ -30,6 +30,8 @@
 #include "transaction_id_define.h"
 #include "split_util.h"
 #include "synchronization_util.h"
+#include "profiler.h"
+#include "util.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -61,6 +63,19 @@
 #ifdef OS_DETECTION_ENABLE
 #    include "os_detection.h"
 #endif
+#ifdef SPLIT_TRANSACTION_DELTA
+#    include "split_delta.h"
+#endif
+#ifdef SPLIT_LINK_STATS_ENABLE
+#    include "split_link_stats.h"
+#endif
+#ifdef SPLIT_TRANSACTION_BUDGET
+#    include "split_budget.h"
+#endif
+#ifdef SPLIT_MATRIX_NOTIFY_PIN
+#    include "gpio.h"
+#    include "keyboard.h"
+#endif
 #ifdef WPM_ENABLE
 #    include "wpm.h"
 #endif
@@ -84,9 +99,32 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#ifdef SPLIT_TRANSACTION_BUDGET
+#    define trans_initiator2target_initializer_priority(member, priority) \
+        { sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), 0, 0, NULL, priority }
+#else // SPLIT_TRANSACTION_BUDGET
+#    define trans_initiator2target_initializer_priority(member, priority) trans_initiator2target_initializer(member)
+#endif // SPLIT_TRANSACTION_BUDGET
+
+#ifdef SPLIT_TRANSACTION_BUNDLE
+// Transactions issued by the sync handlers are collected into bundles
+static bool transaction_bundle_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define transaction_execute_link transaction_bundle_execute
+#else // SPLIT_TRANSACTION_BUNDLE
+#    define transaction_execute_link transport_execute_transaction
+#endif // SPLIT_TRANSACTION_BUNDLE
+
+#ifdef SPLIT_TRANSACTION_BUDGET
+// Transactions are accounted against the link budget of the current scan
+static bool transaction_budget_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+#    define transaction_execute transaction_budget_execute
+#else // SPLIT_TRANSACTION_BUDGET
+#    define transaction_execute transaction_execute_link
+#endif // SPLIT_TRANSACTION_BUDGET
+
+#define transport_write(id, data, length) transaction_execute(id, data, length, NULL, 0)
+#define transport_read(id, data, length) transaction_execute(id, NULL, 0, data, length)
+#define transport_exec(id) transaction_execute(id, NULL, 0, NULL, 0)
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -144,6 +182,19 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         split_shared_memory_unlock();                         \
     } while (0)
 
+#ifdef SPLIT_TRANSACTION_BUDGET
+/**
+ * @brief Handlers of transactions below SPLIT_TRANSACTION_PRIORITY_CRITICAL
+ * are not run in place, but from the transaction schedule after all critical
+ * handlers, in priority order and within the link budget of the scan.
+ */
+#    define TRANSACTION_HANDLER_MASTER_SCHEDULED(prefix)
+#    define TRANSACTION_SCHEDULE_ENTRY(prefix, id) {id, #prefix, &prefix##_handlers_master},
+#else // SPLIT_TRANSACTION_BUDGET
+#    define TRANSACTION_HANDLER_MASTER_SCHEDULED(prefix) TRANSACTION_HANDLER_MASTER(prefix)
+#    define TRANSACTION_SCHEDULE_ENTRY(prefix, id)
+#endif // SPLIT_TRANSACTION_BUDGET
+
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
@@ -159,10 +210,18 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
     return okay;
 }
 
+#ifdef SPLIT_TRANSACTION_DELTA
+static bool transport_write_delta(int8_t trans_id, const void *source, size_t length);
+static void transport_write_full_done(int8_t trans_id, bool okay);
+#endif // SPLIT_TRANSACTION_DELTA
+
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
     bool okay = true;
     if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
         okay &= transport_write(trans_id, source, length);
+#ifdef SPLIT_TRANSACTION_DELTA
+        transport_write_full_done(trans_id, okay);
+#endif // SPLIT_TRANSACTION_DELTA
         if (okay) {
             *last_update = timer_read32();
         }
@@ -172,12 +231,392 @@ inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, boo
 
 inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update, void *source, const void *equiv_shmem, size_t length) {
     // Just run a memcmp to compare the source and equivalent shmem location
-    return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
+    bool changed = memcmp(source, equiv_shmem, length) != 0;
+#ifdef SPLIT_TRANSACTION_DELTA
+    // Changes only send the bytes that differ, the forced sync still sends everything
+    if (changed && transport_write_delta(trans_id, source, length)) {
+        *last_update = timer_read32();
+        return true;
+    }
+#endif // SPLIT_TRANSACTION_DELTA
+    return send_if_condition(trans_id, last_update, changed, source, length);
 }
 
+#ifdef SPLIT_TRANSACTION_DELTA
+// Delta frames are length prefixed, only their used part needs to be transferred
+#    define transaction_initiator2target_length(id, buffer) ((id) == PUT_DELTA ? 1 + ((const uint8_t *)(buffer))[0] : split_transaction_table[id].initiator2target_buffer_size)
+#else // SPLIT_TRANSACTION_DELTA
+#    define transaction_initiator2target_length(id, buffer) (split_transaction_table[id].initiator2target_buffer_size)
+#endif // SPLIT_TRANSACTION_DELTA
+
+////////////////////////////////////////////////////
+// Bundles
+
+#ifdef SPLIT_TRANSACTION_BUNDLE
+
+_Static_assert(NUM_TOTAL_TRANSACTIONS <= 32, "Bundles track transactions in a 32 bit mask");
+
+#    define TRANSACTION_BIT(id) (1UL << (id))
+
+// Checksums requested at the start of every scan, so that their handlers do not need a round trip of their own
+// clang-format off
+static const uint32_t transaction_bundle_prefetch = 0
+#    ifndef SPLIT_MATRIX_NOTIFY_PIN
+    | TRANSACTION_BIT(GET_SLAVE_MATRIX_CHECKSUM)
+#    endif // SPLIT_MATRIX_NOTIFY_PIN
+#    ifdef ENCODER_ENABLE
+    | TRANSACTION_BIT(GET_ENCODERS_CHECKSUM)
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    | TRANSACTION_BIT(GET_POINTING_CHECKSUM)
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    ;
+// clang-format on
+
+static bool     bundle_active  = false;
+static uint32_t bundle_pending = 0; // queued transactions, writes stay queued until they were delivered
+static uint32_t bundle_fresh   = 0; // reads answered by the last bundle that have not been consumed yet
+
+static bool transaction_bundle_fits(int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    return (1 + trans->initiator2target_buffer_size <= SPLIT_TRANSACTION_BUNDLE_SIZE) && (trans->target2initiator_buffer_size <= SPLIT_TRANSACTION_BUNDLE_SIZE);
+}
+
+static void transaction_bundle_drop_reads(void) {
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        if (split_transaction_table[id].target2initiator_buffer_size) {
+            bundle_pending &= ~TRANSACTION_BIT(id);
+        }
+    }
+}
+
+#    ifdef SPLIT_LINK_STATS_ENABLE
+// Records every member of a bundle under its own transaction ID, with the round trip time of the whole bundle
+static void transaction_bundle_record_stats(uint32_t bundled, bool okay, uint32_t start) {
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (bundled & TRANSACTION_BIT(id)) {
+            split_link_stats_record(id, okay, start, transaction_initiator2target_length(id, split_trans_initiator2target_buffer(trans)) + trans->target2initiator_buffer_size);
+        }
+    }
+}
+#    endif // SPLIT_LINK_STATS_ENABLE
+
+/**
+ * Sends all pending transactions to the slave, as few bundles as their buffers fit in. Each entry of a bundle is the
+ * transaction ID followed by its initiator to target buffer, the response holds the target to initiator buffers of the
+ * same entries in order.
+ */
+static bool transaction_bundle_flush(void) {
+    static split_transaction_bundle_t request;
+    static split_transaction_bundle_t response;
+
+    while (bundle_pending) {
+        uint32_t bundled  = 0;
+        uint8_t  expected = 0;
+
+        request.length = 0;
+        for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            if (!(bundle_pending & TRANSACTION_BIT(id))) {
+                continue;
+            }
+            // Anything that does not fit is left for the next bundle
+            uint8_t length = transaction_initiator2target_length(id, split_trans_initiator2target_buffer(trans));
+            if (request.length + 1 + length > SPLIT_TRANSACTION_BUNDLE_SIZE || expected + trans->target2initiator_buffer_size > SPLIT_TRANSACTION_BUNDLE_SIZE) {
+                continue;
+            }
+            request.data[request.length++] = id;
+            memcpy(&request.data[request.length], split_trans_initiator2target_buffer(trans), length);
+            request.length += length;
+            expected += trans->target2initiator_buffer_size;
+            bundled |= TRANSACTION_BIT(id);
+        }
+
+#    ifdef SPLIT_LINK_STATS_ENABLE
+        uint32_t start = split_link_stats_timestamp();
+#    endif // SPLIT_LINK_STATS_ENABLE
+        bool okay = transport_execute_transaction(EXECUTE_BUNDLE, &request, 1 + request.length, &response, 1 + expected) && response.length == expected;
+#    ifdef SPLIT_LINK_STATS_ENABLE
+        transaction_bundle_record_stats(bundled, okay, start);
+#    endif // SPLIT_LINK_STATS_ENABLE
+
+        if (!okay) {
+            // Reads are repeated by their handlers, writes go out with the next bundle
+            transaction_bundle_drop_reads();
+            return false;
+        }
+        bundle_pending &= ~bundled;
+
+        uint8_t offset = 0;
+        for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            if ((bundled & TRANSACTION_BIT(id)) && trans->target2initiator_buffer_size) {
+                memcpy(split_trans_target2initiator_buffer(trans), &response.data[offset], trans->target2initiator_buffer_size);
+                offset += trans->target2initiator_buffer_size;
+                bundle_fresh |= TRANSACTION_BIT(id);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Queues a transaction issued by a sync handler. Writes are deferred until the next read or the end of the scan, a
+ * read sends everything queued so far along with it, unless it was already answered by the previous bundle.
+ */
+static bool transaction_bundle_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (!bundle_active || !transaction_bundle_fits(id)) {
+        return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    if (target2initiator_length == 0) {
+        bundle_pending |= TRANSACTION_BIT(id);
+        return true;
+    }
+
+    if (!(bundle_fresh & TRANSACTION_BIT(id))) {
+        bundle_pending |= TRANSACTION_BIT(id);
+        if (!transaction_bundle_flush()) {
+            return false;
+        }
+    }
+    bundle_fresh &= ~TRANSACTION_BIT(id);
+
+    size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+    memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    return true;
+}
+
+static void transaction_bundle_begin(void) {
+    bundle_active = true;
+    bundle_fresh  = 0;
+    bundle_pending |= transaction_bundle_prefetch;
+}
+
+static bool transaction_bundle_end(bool okay) {
+    // Prefetched reads that no handler asked for are not worth a bundle of their own
+    transaction_bundle_drop_reads();
+    if (okay) {
+        okay = transaction_bundle_flush();
+    }
+    bundle_active = false;
+    return okay;
+}
+
+static void slave_bundle_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const split_transaction_bundle_t *request  = &split_shmem->bundle_request;
+    split_transaction_bundle_t       *response = &split_shmem->bundle_response;
+
+    // A malformed bundle ends early, which the master notices from the response length
+    response->length = 0;
+    uint8_t offset   = 0;
+    while (offset < request->length && request->length <= SPLIT_TRANSACTION_BUNDLE_SIZE) {
+        uint8_t id = request->data[offset++];
+        if (id >= NUM_TOTAL_TRANSACTIONS || id == EXECUTE_BUNDLE) {
+            break;
+        }
+
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (offset >= request->length && trans->initiator2target_buffer_size) {
+            break;
+        }
+        uint8_t length = transaction_initiator2target_length(id, &request->data[offset]);
+        if (length > trans->initiator2target_buffer_size || offset + length > request->length || response->length + trans->target2initiator_buffer_size > SPLIT_TRANSACTION_BUNDLE_SIZE) {
+            break;
+        }
+
+        memcpy(split_trans_initiator2target_buffer(trans), &request->data[offset], length);
+        offset += length;
+
+        if (trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        }
+
+        memcpy(&response->data[response->length], split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+        response->length += trans->target2initiator_buffer_size;
+    }
+}
+
+// clang-format off
+#    define TRANSACTIONS_BUNDLE_REGISTRATIONS \
+    [EXECUTE_BUNDLE] = { sizeof_member(split_shared_memory_t, bundle_request), offsetof(split_shared_memory_t, bundle_request), sizeof_member(split_shared_memory_t, bundle_response), offsetof(split_shared_memory_t, bundle_response), slave_bundle_callback },
+// clang-format on
+
+#else // SPLIT_TRANSACTION_BUNDLE
+
+#    define TRANSACTIONS_BUNDLE_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BUNDLE
+
+////////////////////////////////////////////////////
+// Deltas
+
+#ifdef SPLIT_TRANSACTION_DELTA
+
+// State of every region, the slave only uses the sequence numbers
+static split_delta_state_t delta_states[NUM_TOTAL_TRANSACTIONS];
+
+/**
+ * The transaction buffer is updated before a full write is sent, so after a failed one it may hold contents the slave
+ * never received. Differences are then only sent again once a full write succeeded.
+ */
+static void transport_write_full_done(int8_t trans_id, bool okay) {
+    split_delta_full_write(&delta_states[trans_id], okay);
+}
+
+/**
+ * Sends only the difference between the source and the transaction buffer, which holds what the slave already has.
+ * Returns false if a full write is needed instead, because the difference is not smaller or the slave did not have
+ * the expected contents.
+ */
+static bool transport_write_delta(int8_t trans_id, const void *source, size_t length) {
+    split_transaction_desc_t *trans = &split_transaction_table[trans_id];
+    if (length != trans->initiator2target_buffer_size || !split_delta_base_valid(&delta_states[trans_id])) {
+        return false;
+    }
+#    ifdef SPLIT_TRANSACTION_BUNDLE
+    // A full write still queued in a bundle has not reached the slave either
+    if (bundle_pending & TRANSACTION_BIT(trans_id)) {
+        return false;
+    }
+#    endif // SPLIT_TRANSACTION_BUNDLE
+
+    split_delta_frame_t frame;
+    uint8_t             delta_length = split_delta_encode(source, split_trans_initiator2target_buffer(trans), length, frame.delta, sizeof(frame.delta));
+    // The frame adds the length prefix, transaction ID and sequence number
+    if (delta_length == 0 || 3 + delta_length >= length) {
+        return false;
+    }
+    frame.length         = 2 + delta_length;
+    frame.transaction_id = trans_id;
+    frame.sequence       = delta_states[trans_id].sequence;
+
+    split_delta_ack_t ack;
+    if (!transaction_execute(PUT_DELTA, &frame, 1 + frame.length, &ack, sizeof(ack))) {
+        return false;
+    }
+    // Continue from wherever the slave is, after a rejected frame that is the full write following it
+    delta_states[trans_id].sequence = ack.sequence;
+    if (!ack.accepted) {
+        return false;
+    }
+
+    memcpy(split_trans_initiator2target_buffer(trans), source, length);
+    return true;
+}
+
+static void slave_delta_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const split_delta_frame_t *frame = &split_shmem->delta_frame;
+    split_delta_ack_t         *ack   = &split_shmem->delta_ack;
+
+    ack->accepted = false;
+    ack->sequence = 0;
+
+    int8_t id = frame->transaction_id;
+    if (frame->length < 2 || frame->length > sizeof(*frame) - 1 || id < 0 || id >= NUM_TOTAL_TRANSACTIONS || id == PUT_DELTA) {
+        return;
+    }
+
+    // A repeated or lost frame leaves the sequence numbers out of step, which makes the master fall back to a full write
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (frame->sequence == delta_states[id].sequence && split_delta_apply(split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, frame->delta, frame->length - 2)) {
+        delta_states[id].sequence++;
+        ack->accepted = true;
+        if (trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        }
+    }
+    ack->sequence = delta_states[id].sequence;
+}
+
+// clang-format off
+#    define TRANSACTIONS_DELTA_REGISTRATIONS \
+    [PUT_DELTA] = { sizeof_member(split_shared_memory_t, delta_frame), offsetof(split_shared_memory_t, delta_frame), sizeof_member(split_shared_memory_t, delta_ack), offsetof(split_shared_memory_t, delta_ack), slave_delta_callback },
+// clang-format on
+
+#else // SPLIT_TRANSACTION_DELTA
+
+#    define TRANSACTIONS_DELTA_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_DELTA
+
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_NOTIFY_PIN
+
+// The slave pulls the notify line low while it holds a matrix change the master has not read yet
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t     last_update                    = 0;
+    static uint8_t      last_sequence                  = 0;
+    static bool         notified                       = false; // kept until a read succeeds, the slave releases the line as soon as it answers
+    static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0};
+
+    if (!gpio_read_pin(SPLIT_MATRIX_NOTIFY_PIN)) {
+        notified = true;
+    }
+
+    bool okay = true;
+    if (notified || timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS) {
+        split_slave_matrix_sync_t temp_matrix;
+        okay = transport_read(GET_SLAVE_MATRIX_DATA, &temp_matrix, sizeof(temp_matrix));
+        if (okay) {
+            okay = crc8(temp_matrix.matrix, sizeof(temp_matrix.matrix)) == temp_matrix.checksum;
+        }
+        if (okay) {
+            if (temp_matrix.sequence != last_sequence) {
+                memcpy(last_matrix, temp_matrix.matrix, sizeof(last_matrix));
+                last_sequence = temp_matrix.sequence;
+            }
+            notified    = false;
+            last_update = timer_read32();
+        }
+    }
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (memcmp(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix)) != 0) {
+        memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
+        split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+        split_shmem->smatrix.sequence++;
+        gpio_write_pin_low(SPLIT_MATRIX_NOTIFY_PIN);
+    }
+}
+
+static void slave_matrix_notify_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // The shared memory is locked, the matrix being sent is the latest one
+    gpio_write_pin_high(SPLIT_MATRIX_NOTIFY_PIN);
+}
+
+void split_matrix_notify_init(void) {
+    if (is_keyboard_master()) {
+        gpio_set_pin_input_high(SPLIT_MATRIX_NOTIFY_PIN);
+    } else {
+        split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+        gpio_set_pin_output(SPLIT_MATRIX_NOTIFY_PIN);
+        gpio_write_pin_high(SPLIT_MATRIX_NOTIFY_PIN);
+    }
+}
+
+// clang-format off
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+    [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer_cb(smatrix, slave_matrix_notify_callback),
+// clang-format on
+
+#else // SPLIT_MATRIX_NOTIFY_PIN
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -199,13 +638,15 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 }
 
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+#endif // SPLIT_MATRIX_NOTIFY_PIN
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -352,11 +793,12 @@ static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 }
 
 // clang-format off
-#    define TRANSACTIONS_LAYER_STATE_MASTER() TRANSACTION_HANDLER_MASTER(layer_state)
+#    define TRANSACTIONS_LAYER_STATE_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(layer_state)
 #    define TRANSACTIONS_LAYER_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(layer_state)
 #    define TRANSACTIONS_LAYER_STATE_REGISTRATIONS \
-    [PUT_LAYER_STATE]         = trans_initiator2target_initializer(layers.layer_state), \
-    [PUT_DEFAULT_LAYER_STATE] = trans_initiator2target_initializer(layers.default_layer_state),
+    [PUT_LAYER_STATE]         = trans_initiator2target_initializer_priority(layers.layer_state, SPLIT_TRANSACTION_PRIORITY_NORMAL), \
+    [PUT_DEFAULT_LAYER_STATE] = trans_initiator2target_initializer_priority(layers.default_layer_state, SPLIT_TRANSACTION_PRIORITY_NORMAL),
+#    define TRANSACTIONS_LAYER_STATE_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(layer_state, PUT_LAYER_STATE)
 // clang-format on
 
 #else // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
@@ -364,6 +806,7 @@ static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 #    define TRANSACTIONS_LAYER_STATE_MASTER()
 #    define TRANSACTIONS_LAYER_STATE_SLAVE()
 #    define TRANSACTIONS_LAYER_STATE_REGISTRATIONS
+#    define TRANSACTIONS_LAYER_STATE_SCHEDULE
 
 #endif // !defined(NO_ACTION_LAYER) && defined(SPLIT_LAYER_STATE_ENABLE)
 
@@ -383,15 +826,17 @@ static void led_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     set_split_host_keyboard_leds(split_shmem->led_state);
 }
 
-#    define TRANSACTIONS_LED_STATE_MASTER() TRANSACTION_HANDLER_MASTER(led_state)
+#    define TRANSACTIONS_LED_STATE_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(led_state)
 #    define TRANSACTIONS_LED_STATE_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(led_state)
-#    define TRANSACTIONS_LED_STATE_REGISTRATIONS [PUT_LED_STATE] = trans_initiator2target_initializer(led_state),
+#    define TRANSACTIONS_LED_STATE_REGISTRATIONS [PUT_LED_STATE] = trans_initiator2target_initializer_priority(led_state, SPLIT_TRANSACTION_PRIORITY_NORMAL),
+#    define TRANSACTIONS_LED_STATE_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(led_state, PUT_LED_STATE)
 
 #else // SPLIT_LED_STATE_ENABLE
 
 #    define TRANSACTIONS_LED_STATE_MASTER()
 #    define TRANSACTIONS_LED_STATE_SLAVE()
 #    define TRANSACTIONS_LED_STATE_REGISTRATIONS
+#    define TRANSACTIONS_LED_STATE_SCHEDULE
 
 #endif // SPLIT_LED_STATE_ENABLE
 
@@ -450,15 +895,17 @@ static void mods_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
 #    endif
 }
 
-#    define TRANSACTIONS_MODS_MASTER() TRANSACTION_HANDLER_MASTER(mods)
+#    define TRANSACTIONS_MODS_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(mods)
 #    define TRANSACTIONS_MODS_SLAVE() TRANSACTION_HANDLER_SLAVE(mods)
-#    define TRANSACTIONS_MODS_REGISTRATIONS [PUT_MODS] = trans_initiator2target_initializer(mods),
+#    define TRANSACTIONS_MODS_REGISTRATIONS [PUT_MODS] = trans_initiator2target_initializer_priority(mods, SPLIT_TRANSACTION_PRIORITY_NORMAL),
+#    define TRANSACTIONS_MODS_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(mods, PUT_MODS)
 
 #else // SPLIT_MODS_ENABLE
 
 #    define TRANSACTIONS_MODS_MASTER()
 #    define TRANSACTIONS_MODS_SLAVE()
 #    define TRANSACTIONS_MODS_REGISTRATIONS
+#    define TRANSACTIONS_MODS_SCHEDULE
 
 #endif // SPLIT_MODS_ENABLE
 
@@ -481,15 +928,17 @@ static void backlight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     backlight_level_noeeprom(backlight_level);
 }
 
-#    define TRANSACTIONS_BACKLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(backlight)
+#    define TRANSACTIONS_BACKLIGHT_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(backlight)
 #    define TRANSACTIONS_BACKLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(backlight)
-#    define TRANSACTIONS_BACKLIGHT_REGISTRATIONS [PUT_BACKLIGHT] = trans_initiator2target_initializer(backlight_level),
+#    define TRANSACTIONS_BACKLIGHT_REGISTRATIONS [PUT_BACKLIGHT] = trans_initiator2target_initializer_priority(backlight_level, SPLIT_TRANSACTION_PRIORITY_LOW),
+#    define TRANSACTIONS_BACKLIGHT_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(backlight, PUT_BACKLIGHT)
 
 #else // BACKLIGHT_ENABLE
 
 #    define TRANSACTIONS_BACKLIGHT_MASTER()
 #    define TRANSACTIONS_BACKLIGHT_SLAVE()
 #    define TRANSACTIONS_BACKLIGHT_REGISTRATIONS
+#    define TRANSACTIONS_BACKLIGHT_SCHEDULE
 
 #endif // BACKLIGHT_ENABLE
 
@@ -523,15 +972,17 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     }
 }
 
-#    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(rgblight)
+#    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rgblight)
 #    define TRANSACTIONS_RGBLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(rgblight)
-#    define TRANSACTIONS_RGBLIGHT_REGISTRATIONS [PUT_RGBLIGHT] = trans_initiator2target_initializer(rgblight_sync),
+#    define TRANSACTIONS_RGBLIGHT_REGISTRATIONS [PUT_RGBLIGHT] = trans_initiator2target_initializer_priority(rgblight_sync, SPLIT_TRANSACTION_PRIORITY_LOW),
+#    define TRANSACTIONS_RGBLIGHT_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(rgblight, PUT_RGBLIGHT)
 
 #else // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
 
 #    define TRANSACTIONS_RGBLIGHT_MASTER()
 #    define TRANSACTIONS_RGBLIGHT_SLAVE()
 #    define TRANSACTIONS_RGBLIGHT_REGISTRATIONS
+#    define TRANSACTIONS_RGBLIGHT_SCHEDULE
 
 #endif // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
 
@@ -557,15 +1008,17 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     led_matrix_set_suspend_state(led_suspend_state);
 }
 
-#    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(led_matrix)
+#    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(led_matrix)
 #    define TRANSACTIONS_LED_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(led_matrix)
-#    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer(led_matrix_sync),
+#    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer_priority(led_matrix_sync, SPLIT_TRANSACTION_PRIORITY_LOW),
+#    define TRANSACTIONS_LED_MATRIX_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(led_matrix, PUT_LED_MATRIX)
 
 #else // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
 #    define TRANSACTIONS_LED_MATRIX_MASTER()
 #    define TRANSACTIONS_LED_MATRIX_SLAVE()
 #    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS
+#    define TRANSACTIONS_LED_MATRIX_SCHEDULE
 
 #endif // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
@@ -591,15 +1044,17 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     rgb_matrix_set_suspend_state(rgb_suspend_state);
 }
 
-#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
+#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rgb_matrix)
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer_priority(rgb_matrix_sync, SPLIT_TRANSACTION_PRIORITY_LOW),
+#    define TRANSACTIONS_RGB_MATRIX_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(rgb_matrix, PUT_RGB_MATRIX)
 
 #else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
 #    define TRANSACTIONS_RGB_MATRIX_MASTER()
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE()
 #    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
+#    define TRANSACTIONS_RGB_MATRIX_SCHEDULE
 
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
@@ -618,15 +1073,17 @@ static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_
     set_current_wpm(split_shmem->current_wpm);
 }
 
-#    define TRANSACTIONS_WPM_MASTER() TRANSACTION_HANDLER_MASTER(wpm)
+#    define TRANSACTIONS_WPM_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(wpm)
 #    define TRANSACTIONS_WPM_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(wpm)
-#    define TRANSACTIONS_WPM_REGISTRATIONS [PUT_WPM] = trans_initiator2target_initializer(current_wpm),
+#    define TRANSACTIONS_WPM_REGISTRATIONS [PUT_WPM] = trans_initiator2target_initializer_priority(current_wpm, SPLIT_TRANSACTION_PRIORITY_LOW),
+#    define TRANSACTIONS_WPM_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(wpm, PUT_WPM)
 
 #else // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
 #    define TRANSACTIONS_WPM_MASTER()
 #    define TRANSACTIONS_WPM_SLAVE()
 #    define TRANSACTIONS_WPM_REGISTRATIONS
+#    define TRANSACTIONS_WPM_SCHEDULE
 
 #endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
 
@@ -653,15 +1110,17 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
     }
 }
 
-#    define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER(oled)
+#    define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(oled)
 #    define TRANSACTIONS_OLED_SLAVE() TRANSACTION_HANDLER_SLAVE(oled)
-#    define TRANSACTIONS_OLED_REGISTRATIONS [PUT_OLED] = trans_initiator2target_initializer(current_oled_state),
+#    define TRANSACTIONS_OLED_REGISTRATIONS [PUT_OLED] = trans_initiator2target_initializer_priority(current_oled_state, SPLIT_TRANSACTION_PRIORITY_LOW),
+#    define TRANSACTIONS_OLED_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(oled, PUT_OLED)
 
 #else // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
 #    define TRANSACTIONS_OLED_MASTER()
 #    define TRANSACTIONS_OLED_SLAVE()
 #    define TRANSACTIONS_OLED_REGISTRATIONS
+#    define TRANSACTIONS_OLED_SCHEDULE
 
 #endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
 
@@ -688,15 +1147,17 @@ static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
     }
 }
 
-#    define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER(st7565)
+#    define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(st7565)
 #    define TRANSACTIONS_ST7565_SLAVE() TRANSACTION_HANDLER_SLAVE(st7565)
-#    define TRANSACTIONS_ST7565_REGISTRATIONS [PUT_ST7565] = trans_initiator2target_initializer(current_st7565_state),
+#    define TRANSACTIONS_ST7565_REGISTRATIONS [PUT_ST7565] = trans_initiator2target_initializer_priority(current_st7565_state, SPLIT_TRANSACTION_PRIORITY_LOW),
+#    define TRANSACTIONS_ST7565_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(st7565, PUT_ST7565)
 
 #else // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
 
 #    define TRANSACTIONS_ST7565_MASTER()
 #    define TRANSACTIONS_ST7565_SLAVE()
 #    define TRANSACTIONS_ST7565_REGISTRATIONS
+#    define TRANSACTIONS_ST7565_SCHEDULE
 
 #endif // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
 
@@ -844,9 +1305,10 @@ static void haptic_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
 }
 
 // clang-format off
-#    define TRANSACTIONS_HAPTIC_MASTER() TRANSACTION_HANDLER_MASTER(haptic)
+#    define TRANSACTIONS_HAPTIC_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(haptic)
 #    define TRANSACTIONS_HAPTIC_SLAVE() TRANSACTION_HANDLER_SLAVE(haptic)
-#    define TRANSACTIONS_HAPTIC_REGISTRATIONS [PUT_HAPTIC] = trans_initiator2target_initializer(haptic_sync),
+#    define TRANSACTIONS_HAPTIC_REGISTRATIONS [PUT_HAPTIC] = trans_initiator2target_initializer_priority(haptic_sync, SPLIT_TRANSACTION_PRIORITY_NORMAL),
+#    define TRANSACTIONS_HAPTIC_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(haptic, PUT_HAPTIC)
 // clang-format on
 
 #else // defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)
@@ -854,6 +1316,7 @@ static void haptic_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
 #    define TRANSACTIONS_HAPTIC_MASTER()
 #    define TRANSACTIONS_HAPTIC_SLAVE()
 #    define TRANSACTIONS_HAPTIC_REGISTRATIONS
+#    define TRANSACTIONS_HAPTIC_SCHEDULE
 
 #endif // defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)
 
@@ -873,9 +1336,10 @@ static void activity_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 }
 
 // clang-format off
-#    define TRANSACTIONS_ACTIVITY_MASTER() TRANSACTION_HANDLER_MASTER(activity)
+#    define TRANSACTIONS_ACTIVITY_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(activity)
 #    define TRANSACTIONS_ACTIVITY_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(activity)
-#    define TRANSACTIONS_ACTIVITY_REGISTRATIONS [PUT_ACTIVITY] = trans_initiator2target_initializer(activity_sync),
+#    define TRANSACTIONS_ACTIVITY_REGISTRATIONS [PUT_ACTIVITY] = trans_initiator2target_initializer_priority(activity_sync, SPLIT_TRANSACTION_PRIORITY_LOW),
+#    define TRANSACTIONS_ACTIVITY_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(activity, PUT_ACTIVITY)
 // clang-format on
 
 #else // defined(SPLIT_ACTIVITY_ENABLE)
@@ -883,6 +1347,7 @@ static void activity_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 #    define TRANSACTIONS_ACTIVITY_MASTER()
 #    define TRANSACTIONS_ACTIVITY_SLAVE()
 #    define TRANSACTIONS_ACTIVITY_REGISTRATIONS
+#    define TRANSACTIONS_ACTIVITY_SCHEDULE
 
 #endif // defined(SPLIT_ACTIVITY_ENABLE)
 
@@ -902,18 +1367,51 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
     slave_update_detected_host_os(split_shmem->detected_os);
 }
 
-#    define TRANSACTIONS_DETECTED_OS_MASTER() TRANSACTION_HANDLER_MASTER(detected_os)
+#    define TRANSACTIONS_DETECTED_OS_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(detected_os)
 #    define TRANSACTIONS_DETECTED_OS_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(detected_os)
-#    define TRANSACTIONS_DETECTED_OS_REGISTRATIONS [PUT_DETECTED_OS] = trans_initiator2target_initializer(detected_os),
+#    define TRANSACTIONS_DETECTED_OS_REGISTRATIONS [PUT_DETECTED_OS] = trans_initiator2target_initializer_priority(detected_os, SPLIT_TRANSACTION_PRIORITY_LOW),
+#    define TRANSACTIONS_DETECTED_OS_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(detected_os, PUT_DETECTED_OS)
 
 #else // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
 #    define TRANSACTIONS_DETECTED_OS_MASTER()
 #    define TRANSACTIONS_DETECTED_OS_SLAVE()
 #    define TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+#    define TRANSACTIONS_DETECTED_OS_SCHEDULE
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// Link statistics
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+
+// The combined statistics are pushed at the forced sync rate, so that the slave can display the link health
+static bool link_stats_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t    last_link_stats_update = 0;
+    split_link_stats_t link_stats;
+    split_link_stats_get_total(&link_stats);
+    return send_if_condition(PUT_LINK_STATS, &last_link_stats_update, false, &link_stats, sizeof(link_stats));
+}
+
+static void link_stats_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_link_stats_set_total(&split_shmem->link_stats);
+}
+
+#    define TRANSACTIONS_LINK_STATS_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(link_stats)
+#    define TRANSACTIONS_LINK_STATS_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(link_stats)
+#    define TRANSACTIONS_LINK_STATS_REGISTRATIONS [PUT_LINK_STATS] = trans_initiator2target_initializer_priority(link_stats, SPLIT_TRANSACTION_PRIORITY_LOW),
+#    define TRANSACTIONS_LINK_STATS_SCHEDULE TRANSACTION_SCHEDULE_ENTRY(link_stats, PUT_LINK_STATS)
+
+#else // SPLIT_LINK_STATS_ENABLE
+
+#    define TRANSACTIONS_LINK_STATS_MASTER()
+#    define TRANSACTIONS_LINK_STATS_SLAVE()
+#    define TRANSACTIONS_LINK_STATS_REGISTRATIONS
+#    define TRANSACTIONS_LINK_STATS_SCHEDULE
+
+#endif // SPLIT_LINK_STATS_ENABLE
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -944,6 +1442,9 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_LINK_STATS_REGISTRATIONS
+    TRANSACTIONS_DELTA_REGISTRATIONS
+    TRANSACTIONS_BUNDLE_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -954,7 +1455,64 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
-bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+////////////////////////////////////////////////////
+// Schedule
+
+#ifdef SPLIT_TRANSACTION_BUDGET
+
+typedef struct {
+    int8_t      transaction_id;
+    const char *name;
+    bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
+} transaction_schedule_entry_t;
+
+// clang-format off
+static const transaction_schedule_entry_t transaction_schedule[] = {
+    TRANSACTIONS_LAYER_STATE_SCHEDULE
+    TRANSACTIONS_LED_STATE_SCHEDULE
+    TRANSACTIONS_MODS_SCHEDULE
+    TRANSACTIONS_BACKLIGHT_SCHEDULE
+    TRANSACTIONS_RGBLIGHT_SCHEDULE
+    TRANSACTIONS_LED_MATRIX_SCHEDULE
+    TRANSACTIONS_RGB_MATRIX_SCHEDULE
+    TRANSACTIONS_WPM_SCHEDULE
+    TRANSACTIONS_OLED_SCHEDULE
+    TRANSACTIONS_ST7565_SCHEDULE
+    TRANSACTIONS_HAPTIC_SCHEDULE
+    TRANSACTIONS_ACTIVITY_SCHEDULE
+    TRANSACTIONS_DETECTED_OS_SCHEDULE
+    TRANSACTIONS_LINK_STATS_SCHEDULE
+};
+// clang-format on
+
+_Static_assert(ARRAY_SIZE(transaction_schedule) <= 32, "The schedule tracks handlers in a 32 bit mask");
+
+static uint8_t transaction_deferred_scans[ARRAY_SIZE(transaction_schedule)];
+
+static bool transaction_budget_execute(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_budget_charge(initiator2target_length, target2initiator_length);
+    return transaction_execute_link(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+
+static bool transactions_master_scheduled(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    uint8_t priorities[ARRAY_SIZE(transaction_schedule)];
+    for (uint8_t i = 0; i < ARRAY_SIZE(transaction_schedule); ++i) {
+        priorities[i] = split_transaction_table[transaction_schedule[i].transaction_id].priority;
+    }
+
+    uint32_t done = 0;
+    int8_t   next;
+    while ((next = split_budget_next(priorities, transaction_deferred_scans, ARRAY_SIZE(transaction_schedule), &done, SPLIT_TRANSACTION_BUDGET)) >= 0) {
+        if (!transaction_handler_master(master_matrix, slave_matrix, transaction_schedule[next].name, transaction_schedule[next].handler)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // SPLIT_TRANSACTION_BUDGET
+
+static bool transactions_master_handlers(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -974,7 +1532,27 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_LINK_STATS_MASTER();
+#ifdef SPLIT_TRANSACTION_BUDGET
+    return transactions_master_scheduled(master_matrix, slave_matrix);
+#else  // SPLIT_TRANSACTION_BUDGET
     return true;
+#endif // SPLIT_TRANSACTION_BUDGET
+}
+
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    PROFILER_PROBE_BEGIN(TRANSACTIONS_MASTER);
+#ifdef SPLIT_TRANSACTION_BUDGET
+    split_budget_reset();
+#endif // SPLIT_TRANSACTION_BUDGET
+#ifdef SPLIT_TRANSACTION_BUNDLE
+    transaction_bundle_begin();
+    bool okay = transaction_bundle_end(transactions_master_handlers(master_matrix, slave_matrix));
+#else  // SPLIT_TRANSACTION_BUNDLE
+    bool okay = transactions_master_handlers(master_matrix, slave_matrix);
+#endif // SPLIT_TRANSACTION_BUNDLE
+    PROFILER_PROBE_END(TRANSACTIONS_MASTER);
+    return okay;
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
@@ -997,6 +1575,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_HAPTIC_SLAVE();
     TRANSACTIONS_ACTIVITY_SLAVE();
     TRANSACTIONS_DETECTED_OS_SLAVE();
+    TRANSACTIONS_LINK_STATS_SLAVE();
 }
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -1011,17 +1590,7 @@ void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback)
     split_transaction_table[transaction_id].target2initiator_offset = offsetof(split_shared_memory_t, rpc_s2m_buffer);
 }
 
-bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
-    // Prevent transaction attempts while transport is disconnected
-    if (!is_transport_connected()) {
-        return false;
-    }
-    // Prevent invoking RPC on QMK core sync data
-    if (transaction_id <= GET_RPC_RESP_DATA) return false;
-    // Prevent sizing issues
-    if (initiator2target_buffer_size > RPC_M2S_BUFFER_SIZE) return false;
-    if (target2initiator_buffer_size > RPC_S2M_BUFFER_SIZE) return false;
-
+static bool transaction_rpc_sequence(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
     // Prepare the metadata block
     rpc_sync_info_t info = {.payload = {.transaction_id = transaction_id, .m2s_length = initiator2target_buffer_size, .s2m_length = target2initiator_buffer_size}};
     info.checksum        = crc8(&info.payload, sizeof(info.payload));
@@ -1050,6 +1619,28 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
     return true;
 }
 
+bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    // Prevent transaction attempts while transport is disconnected
+    if (!is_transport_connected()) {
+        return false;
+    }
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id <= GET_RPC_RESP_DATA) return false;
+    // Prevent sizing issues
+    if (initiator2target_buffer_size > RPC_M2S_BUFFER_SIZE) return false;
+    if (target2initiator_buffer_size > RPC_S2M_BUFFER_SIZE) return false;
+
+#    ifdef SPLIT_LINK_STATS_ENABLE
+    // Record the whole sequence under the user transaction, on top of the individual RPC transactions
+    uint32_t start = split_link_stats_timestamp();
+    bool     okay  = transaction_rpc_sequence(transaction_id, initiator2target_buffer_size, initiator2target_buffer, target2initiator_buffer_size, target2initiator_buffer);
+    split_link_stats_record(transaction_id, okay, start, initiator2target_buffer_size + target2initiator_buffer_size);
+    return okay;
+#    else
+    return transaction_rpc_sequence(transaction_id, initiator2target_buffer_size, initiator2target_buffer, target2initiator_buffer_size, target2initiator_buffer);
+#    endif
+}
+
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
     // The RPC info block contains the intended transaction ID, as well as the sizes for both inbound and outbound data.
     // Ignore the args -- the `split_shmem` already has the info, we just need to act upon it.
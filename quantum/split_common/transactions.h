@@ -25,6 +25,13 @@
 
 typedef void (*slave_callback_t)(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 
+// Split transaction priority classes, critical transactions are never deferred
+typedef enum {
+    SPLIT_TRANSACTION_PRIORITY_CRITICAL = 0,
+    SPLIT_TRANSACTION_PRIORITY_NORMAL,
+    SPLIT_TRANSACTION_PRIORITY_LOW,
+} split_transaction_priority_t;
+
 // Split transaction Descriptor
 typedef struct _split_transaction_desc_t {
     uint8_t          initiator2target_buffer_size;
@@ -32,6 +39,9 @@ typedef struct _split_transaction_desc_t {
     uint8_t          target2initiator_buffer_size;
     uint16_t         target2initiator_offset;
     slave_callback_t slave_callback;
+#ifdef SPLIT_TRANSACTION_BUDGET
+    uint8_t priority; // split_transaction_priority_t
+#endif // SPLIT_TRANSACTION_BUDGET
 } split_transaction_desc_t;
 
 // Forward declaration for the split transactions
@@ -45,6 +55,10 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
+#ifdef SPLIT_MATRIX_NOTIFY_PIN
+void split_matrix_notify_init(void);
+#endif // SPLIT_MATRIX_NOTIFY_PIN
+
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
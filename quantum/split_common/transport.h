@@ -31,6 +31,14 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifndef SPLIT_TRANSACTION_DELTA_SIZE
+#    define SPLIT_TRANSACTION_DELTA_SIZE 16
+#endif // SPLIT_TRANSACTION_DELTA_SIZE
+
+#ifndef SPLIT_TRANSACTION_BUNDLE_SIZE
+#    define SPLIT_TRANSACTION_BUNDLE_SIZE 32
+#endif // SPLIT_TRANSACTION_BUNDLE_SIZE
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -53,7 +61,10 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #endif // RGBLIGHT_ENABLE
 
 typedef struct _split_slave_matrix_sync_t {
-    uint8_t      checksum;
+    uint8_t checksum;
+#ifdef SPLIT_MATRIX_NOTIFY_PIN
+    uint8_t sequence;
+#endif // SPLIT_MATRIX_NOTIFY_PIN
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
@@ -143,10 +154,37 @@ typedef struct _rpc_sync_info_t {
 } rpc_sync_info_t;
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#ifdef SPLIT_TRANSACTION_DELTA
+// Length prefixed frame, applying an encoded difference to the buffer of another transaction
+typedef struct _split_delta_frame_t {
+    uint8_t length;
+    int8_t  transaction_id;
+    uint8_t sequence; // the sequence number of the region the difference is based on
+    uint8_t delta[SPLIT_TRANSACTION_DELTA_SIZE];
+} split_delta_frame_t;
+
+typedef struct _split_delta_ack_t {
+    bool    accepted;
+    uint8_t sequence; // the sequence number of the region after the frame was handled
+} split_delta_ack_t;
+#endif // SPLIT_TRANSACTION_DELTA
+
+#ifdef SPLIT_TRANSACTION_BUNDLE
+// Length prefixed frame, only the used part needs to be transferred
+typedef struct _split_transaction_bundle_t {
+    uint8_t length;
+    uint8_t data[SPLIT_TRANSACTION_BUNDLE_SIZE];
+} split_transaction_bundle_t;
+#endif // SPLIT_TRANSACTION_BUNDLE
+
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_LINK_STATS_ENABLE
+#    include "split_link_stats.h"
+#endif // SPLIT_LINK_STATS_ENABLE
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -222,12 +260,26 @@ typedef struct _split_shared_memory_t {
     split_slave_activity_sync_t activity_sync;
 #endif // defined(SPLIT_ACTIVITY_ENABLE)
 
+#ifdef SPLIT_LINK_STATS_ENABLE
+    split_link_stats_t link_stats;
+#endif // SPLIT_LINK_STATS_ENABLE
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
     uint8_t         rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+#ifdef SPLIT_TRANSACTION_DELTA
+    split_delta_frame_t delta_frame;
+    split_delta_ack_t   delta_ack;
+#endif // SPLIT_TRANSACTION_DELTA
+
+#ifdef SPLIT_TRANSACTION_BUNDLE
+    split_transaction_bundle_t bundle_request;
+    split_transaction_bundle_t bundle_response;
+#endif // SPLIT_TRANSACTION_BUNDLE
+
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
     os_variant_t detected_os;
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
@@ -0,0 +1,126 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Lock-free single producer, single consumer queue, for passing events from interrupt context to the main loop
+ * without entering a critical section.
+ *
+ * SPSC_QUEUE_DECLARE(name, type, size) declares the queue type name_t holding up to size elements of the given type,
+ * along with the following functions:
+ *
+ *     void    name_init(name_t *queue);
+ *     bool    name_push(name_t *queue, type value);           // producer, drops the new element if full
+ *     bool    name_push_overwrite(name_t *queue, type value); // producer, discards the oldest element if full
+ *     bool    name_pop(name_t *queue, type *value);           // consumer
+ *     void    name_clear(name_t *queue);                      // consumer
+ *     uint8_t name_count(const name_t *queue);
+ *     bool    name_empty(const name_t *queue);
+ *     bool    name_full(const name_t *queue);
+ *
+ * The size has to be a power of two, no larger than 128. head and tail are free running counters, only ever written
+ * by the producer and the consumer respectively, and their difference is the number of queued elements.
+ *
+ * The push functions return false if an element was lost. name_push_overwrite requires that the producer cannot be
+ * interrupted by the consumer, as is the case for an interrupt handler feeding the main loop, and that the consumer
+ * catches up before 256 - size further elements have been pushed.
+ */
+#define SPSC_QUEUE_DECLARE(name, type, size)                                                                       \
+    SPSC_QUEUE_STATIC_ASSERT((size) > 0 && (size) <= 128 && ((size) & ((size)-1)) == 0, "Invalid queue size");     \
+                                                                                                                   \
+    typedef struct name##_t {                                                                                      \
+        volatile uint8_t head;                                                                                     \
+        volatile uint8_t tail;                                                                                     \
+        type             buffer[size];                                                                             \
+    } name##_t;                                                                                                    \
+                                                                                                                   \
+    static inline void name##_init(name##_t *queue) {                                                              \
+        queue->head = 0;                                                                                           \
+        queue->tail = 0;                                                                                           \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline uint8_t name##_count(const name##_t *queue) {                                                    \
+        uint8_t count = queue->head - queue->tail;                                                                 \
+        return count > (size) ? (size) : count;                                                                    \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline bool name##_empty(const name##_t *queue) {                                                       \
+        return queue->head == queue->tail;                                                                         \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline bool name##_full(const name##_t *queue) {                                                        \
+        return name##_count(queue) == (size);                                                                      \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline bool name##_push(name##_t *queue, type value) {                                                  \
+        uint8_t head = queue->head;                                                                                \
+        if ((uint8_t)(head - queue->tail) >= (size)) {                                                             \
+            return false;                                                                                          \
+        }                                                                                                          \
+        /* The slot may only be reused once the consumer has released it */                                        \
+        SPSC_QUEUE_BARRIER();                                                                                      \
+        queue->buffer[head & ((size)-1)] = value;                                                                  \
+        /* The element has to be complete before it is published */                                                \
+        SPSC_QUEUE_BARRIER();                                                                                      \
+        queue->head = head + 1;                                                                                    \
+        return true;                                                                                               \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline bool name##_push_overwrite(name##_t *queue, type value) {                                        \
+        uint8_t head = queue->head;                                                                                \
+        bool    kept = (uint8_t)(head - queue->tail) < (size);                                                     \
+        queue->buffer[head & ((size)-1)] = value;                                                                  \
+        SPSC_QUEUE_BARRIER();                                                                                      \
+        queue->head = head + 1;                                                                                    \
+        return kept;                                                                                               \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline bool name##_pop(name##_t *queue, type *value) {                                                  \
+        for (;;) {                                                                                                 \
+            uint8_t head = queue->head;                                                                            \
+            uint8_t tail = queue->tail;                                                                            \
+            if (head == tail) {                                                                                    \
+                return false;                                                                                      \
+            }                                                                                                      \
+            /* Skip the elements that were overwritten since the last pop */                                       \
+            if ((uint8_t)(head - tail) > (size)) {                                                                 \
+                tail = head - (size);                                                                              \
+            }                                                                                                      \
+            SPSC_QUEUE_BARRIER();                                                                                  \
+            *value = queue->buffer[tail & ((size)-1)];                                                             \
+            SPSC_QUEUE_BARRIER();                                                                                  \
+            /* Retry if the element was overwritten while it was read */                                           \
+            if ((uint8_t)(queue->head - tail) > (size)) {                                                          \
+                continue;                                                                                          \
+            }                                                                                                      \
+            queue->tail = tail + 1;                                                                                \
+            return true;                                                                                           \
+        }                                                                                                          \
+    }                                                                                                              \
+                                                                                                                   \
+    static inline void name##_clear(name##_t *queue) {                                                             \
+        queue->tail = queue->head;                                                                                 \
+    }
+
+/**
+ * @def Smallest valid queue size that holds at least n elements, and at least 4.
+ */
+#define SPSC_QUEUE_SIZE_FOR(n) ((n) <= 4 ? 4 : (n) <= 8 ? 8 : (n) <= 16 ? 16 : (n) <= 32 ? 32 : (n) <= 64 ? 64 : 128)
+
+#if defined(__AVR__)
+// Single core without caches or out of order accesses, only the compiler needs to be kept from reordering
+#    define SPSC_QUEUE_BARRIER() __asm__ __volatile__("" ::: "memory")
+#else
+// Emits a DMB on Cortex-M, which also covers a second core or DMA observing the queue
+#    define SPSC_QUEUE_BARRIER() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#ifdef __cplusplus
+#    define SPSC_QUEUE_STATIC_ASSERT static_assert
+#else
+#    define SPSC_QUEUE_STATIC_ASSERT _Static_assert
+#endif
@@ -0,0 +1,2 @@
+spsc_queue_SRC := \
+    $(QUANTUM_PATH)/spsc_queue/tests/spsc_queue_tests.cpp
@@ -0,0 +1,168 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <thread>
+
+extern "C" {
+#include "spsc_queue.h"
+}
+
+SPSC_QUEUE_DECLARE(byte_queue, uint8_t, 8)
+
+typedef struct {
+    uint16_t id;
+    uint8_t  payload;
+} event_t;
+
+SPSC_QUEUE_DECLARE(event_queue, event_t, 4)
+
+SPSC_QUEUE_DECLARE(stress_queue, uint32_t, 16)
+
+class SpscQueue : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        byte_queue_init(&queue);
+    }
+
+    byte_queue_t queue;
+};
+
+TEST_F(SpscQueue, StartsEmpty) {
+    uint8_t value;
+    EXPECT_TRUE(byte_queue_empty(&queue));
+    EXPECT_FALSE(byte_queue_full(&queue));
+    EXPECT_EQ(byte_queue_count(&queue), 0);
+    EXPECT_FALSE(byte_queue_pop(&queue, &value));
+}
+
+TEST_F(SpscQueue, PopsInOrder) {
+    for (uint8_t i = 0; i < 5; i++) {
+        EXPECT_TRUE(byte_queue_push(&queue, i));
+    }
+    EXPECT_EQ(byte_queue_count(&queue), 5);
+
+    uint8_t value;
+    for (uint8_t i = 0; i < 5; i++) {
+        EXPECT_TRUE(byte_queue_pop(&queue, &value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(byte_queue_empty(&queue));
+}
+
+TEST_F(SpscQueue, UsesFullCapacity) {
+    for (uint8_t i = 0; i < 8; i++) {
+        EXPECT_TRUE(byte_queue_push(&queue, i));
+    }
+    EXPECT_TRUE(byte_queue_full(&queue));
+    EXPECT_EQ(byte_queue_count(&queue), 8);
+}
+
+TEST_F(SpscQueue, PushDropsNewestWhenFull) {
+    for (uint8_t i = 0; i < 8; i++) {
+        byte_queue_push(&queue, i);
+    }
+    EXPECT_FALSE(byte_queue_push(&queue, 100));
+    EXPECT_EQ(byte_queue_count(&queue), 8);
+
+    uint8_t value;
+    for (uint8_t i = 0; i < 8; i++) {
+        EXPECT_TRUE(byte_queue_pop(&queue, &value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(byte_queue_pop(&queue, &value));
+}
+
+TEST_F(SpscQueue, PushOverwriteDiscardsOldestWhenFull) {
+    for (uint8_t i = 0; i < 8; i++) {
+        EXPECT_TRUE(byte_queue_push_overwrite(&queue, i));
+    }
+    EXPECT_FALSE(byte_queue_push_overwrite(&queue, 8));
+    EXPECT_FALSE(byte_queue_push_overwrite(&queue, 9));
+    EXPECT_EQ(byte_queue_count(&queue), 8);
+
+    uint8_t value;
+    for (uint8_t i = 2; i < 10; i++) {
+        EXPECT_TRUE(byte_queue_pop(&queue, &value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(byte_queue_empty(&queue));
+}
+
+TEST_F(SpscQueue, PushOverwriteSkipsSeveralLaps) {
+    for (uint8_t i = 0; i < 100; i++) {
+        byte_queue_push_overwrite(&queue, i);
+    }
+
+    uint8_t value;
+    for (uint8_t i = 92; i < 100; i++) {
+        EXPECT_TRUE(byte_queue_pop(&queue, &value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(byte_queue_pop(&queue, &value));
+}
+
+TEST_F(SpscQueue, CountersWrapAround) {
+    uint8_t value;
+    for (uint16_t i = 0; i < 1000; i++) {
+        EXPECT_TRUE(byte_queue_push(&queue, i & 0xFF));
+        EXPECT_TRUE(byte_queue_push(&queue, (i + 1) & 0xFF));
+        EXPECT_EQ(byte_queue_count(&queue), 2);
+        EXPECT_TRUE(byte_queue_pop(&queue, &value));
+        EXPECT_EQ(value, i & 0xFF);
+        EXPECT_TRUE(byte_queue_pop(&queue, &value));
+        EXPECT_EQ(value, (i + 1) & 0xFF);
+    }
+    EXPECT_TRUE(byte_queue_empty(&queue));
+}
+
+TEST_F(SpscQueue, ClearDiscardsQueuedElements) {
+    byte_queue_push(&queue, 1);
+    byte_queue_push(&queue, 2);
+    byte_queue_clear(&queue);
+    EXPECT_TRUE(byte_queue_empty(&queue));
+
+    uint8_t value;
+    EXPECT_TRUE(byte_queue_push(&queue, 3));
+    EXPECT_TRUE(byte_queue_pop(&queue, &value));
+    EXPECT_EQ(value, 3);
+}
+
+TEST(SpscQueueTypes, HoldsStructs) {
+    event_queue_t queue;
+    event_queue_init(&queue);
+
+    event_t event = {0x1234, 0x56};
+    EXPECT_TRUE(event_queue_push(&queue, event));
+
+    event_t result;
+    EXPECT_TRUE(event_queue_pop(&queue, &result));
+    EXPECT_EQ(result.id, 0x1234);
+    EXPECT_EQ(result.payload, 0x56);
+}
+
+TEST(SpscQueueConcurrency, ProducerAndConsumerThreads) {
+    static stress_queue_t queue;
+    stress_queue_init(&queue);
+
+    const uint32_t count    = 200000;
+    std::thread    producer = std::thread([&]() {
+        for (uint32_t i = 0; i < count;) {
+            if (stress_queue_push(&queue, i)) {
+                i++;
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    while (expected < count) {
+        uint32_t value;
+        if (stress_queue_pop(&queue, &value)) {
+            ASSERT_EQ(value, expected);
+            expected++;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(stress_queue_empty(&queue));
+}
@@ -0,0 +1,151 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include "task_scheduler.h"
+#include "timer.h"
+
+static scheduled_task_t scheduled_tasks[TASK_SCHEDULER_MAX_TASKS] = {0};
+static uint8_t          scheduled_task_count                      = 0;
+
+//------------------------------------
+// Helpers
+//
+
+static inline int32_t task_lateness(const scheduled_task_t *entry, uint32_t now) {
+    return (int32_t)TIMER_DIFF_32(now, entry->next_run);
+}
+
+static inline bool task_is_due(const scheduled_task_t *entry, uint32_t now) {
+    return task_lateness(entry, now) >= 0;
+}
+
+static inline bool task_is_past_deadline(const scheduled_task_t *entry, uint32_t now) {
+    return entry->deadline_ms && task_lateness(entry, now) > entry->deadline_ms;
+}
+
+// Returns true if `a` should be executed before `b`. Tasks that have already missed their deadline take precedence over
+// everything else, so that low priority work is delayed but never starved.
+static bool task_is_more_urgent(const scheduled_task_t *a, const scheduled_task_t *b, uint32_t now) {
+    bool a_late = task_is_past_deadline(a, now);
+    bool b_late = task_is_past_deadline(b, now);
+    if (a_late != b_late) {
+        return a_late;
+    }
+    if (a->priority != b->priority) {
+        return a->priority < b->priority;
+    }
+    return task_lateness(a, now) > task_lateness(b, now);
+}
+
+static scheduled_task_t *find_task(scheduled_task_func_t task) {
+    for (uint8_t i = 0; i < scheduled_task_count; ++i) {
+        if (scheduled_tasks[i].task == task) {
+            return &scheduled_tasks[i];
+        }
+    }
+    return NULL;
+}
+
+//------------------------------------
+// Registration
+//
+
+bool task_scheduler_register(scheduled_task_func_t task, task_priority_t priority, uint16_t period_ms, uint16_t deadline_ms) {
+    if (!task || scheduled_task_count >= TASK_SCHEDULER_MAX_TASKS || find_task(task)) {
+        return false;
+    }
+
+    scheduled_tasks[scheduled_task_count++] = (scheduled_task_t){
+        .task        = task,
+        .next_run    = timer_read32(),
+        .period_ms   = period_ms,
+        .deadline_ms = deadline_ms,
+        .priority    = priority,
+    };
+    return true;
+}
+
+bool task_scheduler_unregister(scheduled_task_func_t task) {
+    scheduled_task_t *entry = find_task(task);
+    if (!entry) {
+        return false;
+    }
+
+    // Keep the table packed, preserving registration order
+    for (scheduled_task_t *last = &scheduled_tasks[scheduled_task_count - 1]; entry < last; ++entry) {
+        *entry = *(entry + 1);
+    }
+    --scheduled_task_count;
+    return true;
+}
+
+const scheduled_task_t *task_scheduler_get(scheduled_task_func_t task) {
+    return find_task(task);
+}
+
+void task_scheduler_reset_stats(void) {
+    for (uint8_t i = 0; i < scheduled_task_count; ++i) {
+        scheduled_tasks[i].overruns        = 0;
+        scheduled_tasks[i].max_lateness_ms = 0;
+    }
+}
+
+void task_scheduler_clear(void) {
+    scheduled_task_count = 0;
+}
+
+//------------------------------------
+// Execution
+//
+
+void task_scheduler_task(void) {
+    const uint32_t start   = timer_read32();
+    uint32_t       now     = start;
+    uint32_t       visited = 0;
+
+    while (true) {
+        // Pick the most urgent task that is due and hasn't already run during this iteration
+        int8_t best = -1;
+        for (uint8_t i = 0; i < scheduled_task_count; ++i) {
+            scheduled_task_t *entry = &scheduled_tasks[i];
+            if ((visited & (1UL << i)) || !task_is_due(entry, now)) {
+                continue;
+            }
+            if (best < 0 || task_is_more_urgent(entry, &scheduled_tasks[best], now)) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+
+        scheduled_task_t *entry    = &scheduled_tasks[best];
+        int32_t           lateness = task_lateness(entry, now);
+        if (lateness > entry->max_lateness_ms) {
+            entry->max_lateness_ms = lateness > UINT16_MAX ? UINT16_MAX : lateness;
+        }
+        if (task_is_past_deadline(entry, now) && entry->overruns < UINT16_MAX) {
+            ++entry->overruns;
+        }
+
+        visited |= (1UL << best);
+        entry->task();
+        now = timer_read32();
+
+        if (entry->period_ms == 0) {
+            entry->next_run = now;
+        } else {
+            // Keep the cadence relative to the previous due time, unless we've fallen more than a whole period behind
+            entry->next_run += entry->period_ms;
+            if (task_lateness(entry, now) >= (int32_t)entry->period_ms) {
+                entry->next_run = now + entry->period_ms;
+            }
+        }
+
+        // Yield back to the main loop so that matrix scanning isn't held up by a burst of scheduled work
+        if (TIMER_DIFF_32(now, start) >= TASK_SCHEDULER_BUDGET_MS) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @def The maximum number of tasks that can be registered with the scheduler, including the core tasks registered by keyboard_init().
+ */
+#ifndef TASK_SCHEDULER_MAX_TASKS
+#    define TASK_SCHEDULER_MAX_TASKS 12
+#endif
+
+/**
+ * @def The number of milliseconds scheduled tasks may consume per main loop iteration before yielding back to matrix scanning.
+ * At least one due task is always executed per iteration, so that progress is made even when a single task exceeds the budget.
+ */
+#ifndef TASK_SCHEDULER_BUDGET_MS
+#    define TASK_SCHEDULER_BUDGET_MS 1
+#endif
+
+/**
+ * @def Default deadlines (maximum lateness in milliseconds) applied to the core tasks.
+ */
+#ifndef TASK_SCHEDULER_NORMAL_PRIORITY_DEADLINE
+#    define TASK_SCHEDULER_NORMAL_PRIORITY_DEADLINE 10
+#endif
+#ifndef TASK_SCHEDULER_LOW_PRIORITY_DEADLINE
+#    define TASK_SCHEDULER_LOW_PRIORITY_DEADLINE 50
+#endif
+
+#if TASK_SCHEDULER_MAX_TASKS > 32
+#    error "TASK_SCHEDULER_MAX_TASKS must not exceed 32"
+#endif
+
+/**
+ * @typedef Priority class of a scheduled task. Lower values are executed first.
+ */
+typedef enum task_priority_t {
+    TASK_PRIORITY_HIGH,
+    TASK_PRIORITY_NORMAL,
+    TASK_PRIORITY_LOW,
+} task_priority_t;
+
+/**
+ * @typedef Function executed by the scheduler.
+ */
+typedef void (*scheduled_task_func_t)(void);
+
+/**
+ * @struct Scheduler table entry.
+ * @brief Code outside task_scheduler.c should only read the statistics members.
+ */
+typedef struct scheduled_task_t {
+    scheduled_task_func_t task;
+    uint32_t              next_run;
+    uint16_t              period_ms;
+    uint16_t              deadline_ms;
+    uint16_t              overruns;
+    uint16_t              max_lateness_ms;
+    task_priority_t       priority;
+} scheduled_task_t;
+
+/**
+ * Registers a task with the scheduler.
+ *
+ * @param task[in] the function to invoke
+ * @param priority[in] the priority class of the task
+ * @param period_ms[in] the minimum number of milliseconds between invocations, zero to run every main loop iteration
+ * @param deadline_ms[in] the number of milliseconds the task may be delayed past its due time before an overrun is counted, zero for no deadline
+ * @return true if the task was registered, false if the table is full or the task is already registered
+ */
+bool task_scheduler_register(scheduled_task_func_t task, task_priority_t priority, uint16_t period_ms, uint16_t deadline_ms);
+
+/**
+ * Removes a task from the scheduler.
+ *
+ * @param task[in] the function previously passed to task_scheduler_register()
+ * @return true if the task was found and removed
+ */
+bool task_scheduler_unregister(scheduled_task_func_t task);
+
+/**
+ * Retrieves the scheduler entry for a registered task, allowing inspection of its overrun statistics.
+ *
+ * @param task[in] the function previously passed to task_scheduler_register()
+ * @return the entry, or NULL if the task is not registered
+ */
+const scheduled_task_t *task_scheduler_get(scheduled_task_func_t task);
+
+/**
+ * Clears the overrun statistics of all registered tasks.
+ */
+void task_scheduler_reset_stats(void);
+
+/**
+ * Removes all registered tasks.
+ */
+void task_scheduler_clear(void);
+
+/**
+ * Executes due tasks in priority order until the per-iteration budget is exhausted. Should not be invoked by keyboard/user code.
+ */
+void task_scheduler_task(void);
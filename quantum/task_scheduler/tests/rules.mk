@@ -0,0 +1,6 @@
+task_scheduler_DEFS := -DTASK_SCHEDULER_ENABLE -DTASK_SCHEDULER_MAX_TASKS=4
+
+task_scheduler_SRC := \
+    $(QUANTUM_PATH)/task_scheduler/tests/task_scheduler_tests.cpp \
+    $(QUANTUM_PATH)/task_scheduler.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -0,0 +1,98 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+extern "C" {
+#include "task_scheduler.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+static std::string execution_log;
+
+static void task_a(void) {
+    execution_log += 'a';
+}
+static void task_b(void) {
+    execution_log += 'b';
+}
+static void task_c(void) {
+    execution_log += 'c';
+}
+static void slow_task(void) {
+    execution_log += 's';
+    advance_time(5);
+}
+
+class TaskScheduler : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        task_scheduler_clear();
+        execution_log.clear();
+    }
+};
+
+TEST_F(TaskScheduler, RunsInPriorityOrder) {
+    EXPECT_TRUE(task_scheduler_register(task_a, TASK_PRIORITY_LOW, 0, 0));
+    EXPECT_TRUE(task_scheduler_register(task_b, TASK_PRIORITY_HIGH, 0, 0));
+    EXPECT_TRUE(task_scheduler_register(task_c, TASK_PRIORITY_NORMAL, 0, 0));
+    task_scheduler_task();
+    EXPECT_EQ(execution_log, "bca");
+}
+
+TEST_F(TaskScheduler, RejectsDuplicatesAndOverflow) {
+    EXPECT_TRUE(task_scheduler_register(task_a, TASK_PRIORITY_LOW, 0, 0));
+    EXPECT_FALSE(task_scheduler_register(task_a, TASK_PRIORITY_LOW, 0, 0));
+    EXPECT_TRUE(task_scheduler_register(task_b, TASK_PRIORITY_LOW, 0, 0));
+    EXPECT_TRUE(task_scheduler_register(task_c, TASK_PRIORITY_LOW, 0, 0));
+    EXPECT_TRUE(task_scheduler_register(slow_task, TASK_PRIORITY_LOW, 0, 0));
+    EXPECT_FALSE(task_scheduler_register([]() {}, TASK_PRIORITY_LOW, 0, 0));
+    EXPECT_TRUE(task_scheduler_unregister(task_b));
+    EXPECT_FALSE(task_scheduler_unregister(task_b));
+    EXPECT_EQ(task_scheduler_get(task_b), nullptr);
+    EXPECT_NE(task_scheduler_get(task_c), nullptr);
+}
+
+TEST_F(TaskScheduler, HonoursPeriod) {
+    task_scheduler_register(task_a, TASK_PRIORITY_NORMAL, 10, 0);
+    task_scheduler_task();
+    EXPECT_EQ(execution_log, "a");
+    advance_time(9);
+    task_scheduler_task();
+    EXPECT_EQ(execution_log, "a");
+    advance_time(1);
+    task_scheduler_task();
+    EXPECT_EQ(execution_log, "aa");
+}
+
+TEST_F(TaskScheduler, YieldsWhenBudgetExhausted) {
+    task_scheduler_register(slow_task, TASK_PRIORITY_HIGH, 0, 0);
+    task_scheduler_register(task_a, TASK_PRIORITY_LOW, 0, 0);
+    task_scheduler_task();
+    EXPECT_EQ(execution_log, "s");
+    task_scheduler_task();
+    EXPECT_EQ(execution_log, "ss");
+}
+
+TEST_F(TaskScheduler, LateTasksAreNotStarvedAndCountOverruns) {
+    task_scheduler_register(slow_task, TASK_PRIORITY_HIGH, 0, 0);
+    task_scheduler_register(task_a, TASK_PRIORITY_LOW, 0, 8);
+    task_scheduler_task(); // s, time 5
+    task_scheduler_task(); // s, time 10
+    EXPECT_EQ(execution_log, "ss");
+    task_scheduler_task(); // a is 10ms late, past its 8ms deadline, so it goes first
+    EXPECT_EQ(execution_log, "ssas");
+    const scheduled_task_t *entry = task_scheduler_get(task_a);
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->overruns, 1);
+    EXPECT_EQ(entry->max_lateness_ms, 10);
+    task_scheduler_reset_stats();
+    EXPECT_EQ(entry->overruns, 0);
+    EXPECT_EQ(entry->max_lateness_ms, 0);
+}
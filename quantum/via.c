@@ -53,6 +53,14 @@
 #    include "rgb_matrix.h"
 #endif
 
+#if defined(PROFILER_ENABLE)
+#    include "profiler.h"
+#endif
+
+#if defined(SPLIT_LINK_STATS_ENABLE) && defined(SPLIT_COMMON_TRANSACTIONS)
+#    include "split_link_stats.h"
+#endif
+
 #if defined(LED_MATRIX_ENABLE)
 #    include "led_matrix.h"
 #endif
@@ -112,6 +120,10 @@ void eeconfig_init_via(void) {
     dynamic_keymap_reset();
     // This resets the macros in EEPROM to nothing.
     dynamic_keymap_macro_reset();
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    // The resets above only reach the RAM mirror, they have to be in EEPROM before it is marked valid
+    dynamic_keymap_flush();
+#endif
     // Save the magic number last, in case saving was interrupted
     via_eeprom_set_valid(true);
 }
@@ -286,6 +298,20 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         return;
     }
 
+#if defined(PROFILER_ENABLE)
+    if (profiler_raw_hid_receive(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+
+#if defined(SPLIT_LINK_STATS_ENABLE) && defined(SPLIT_COMMON_TRANSACTIONS)
+    if (split_link_stats_raw_hid_receive(data, length)) {
+        raw_hid_send(data, length);
+        return;
+    }
+#endif
+
     switch (*command_id) {
         case id_get_protocol_version: {
             command_data[0] = VIA_PROTOCOL_VERSION >> 8;
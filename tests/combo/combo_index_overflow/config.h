@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Too small for the keys of all combos, but enough for one key per combo
+#define COMBO_INDEX_SIZE 3
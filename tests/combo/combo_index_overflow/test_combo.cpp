@@ -0,0 +1,35 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "quantum.h"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+class ComboIndexOverflow : public TestFixture {};
+
+TEST_F(ComboIndexOverflow, combos_trigger_without_index) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    KeymapKey  key_o(0, 0, 3, KC_O);
+    set_keymap({key_y, key_u, key_o});
+
+    EXPECT_REPORT(driver, (KC_ESCAPE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_u, key_o});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_SPACE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_y, key_u});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_O));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_o);
+    VERIFY_AND_CLEAR(driver);
+}
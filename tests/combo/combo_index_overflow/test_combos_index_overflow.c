@@ -0,0 +1,16 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+enum combos { space, escape };
+
+uint16_t const space_combo[]  = {KC_Y, KC_U, COMBO_END};
+uint16_t const escape_combo[] = {KC_U, KC_O, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [space]  = COMBO(space_combo, KC_SPACE),
+    [escape] = COMBO(escape_combo, KC_ESC)
+};
+// clang-format on
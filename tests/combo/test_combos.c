@@ -4,14 +4,16 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #include "quantum.h"
 
-enum combos { modtest, osmshift };
+enum combos { modtest, osmshift, escape };
 
 uint16_t const modtest_combo[]  = {KC_Y, KC_U, COMBO_END};
 uint16_t const osmshift_combo[] = {KC_Z, KC_X, COMBO_END};
+uint16_t const escape_combo[]   = {KC_U, KC_O, COMBO_END};
 
 // clang-format off
 combo_t key_combos[] = {
     [modtest]  = COMBO(modtest_combo, RSFT_T(KC_SPACE)),
-    [osmshift] = COMBO(osmshift_combo, OSM(MOD_LSFT))
+    [osmshift] = COMBO(osmshift_combo, OSM(MOD_LSFT)),
+    [escape]   = COMBO(escape_combo, KC_ESC)
 };
 // clang-format on
@@ -0,0 +1,22 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+extern const key_override_t delete_override;
+extern const key_override_t ctrl_a_override;
+
+// More key overrides are provided at runtime than the index can hold
+uint16_t key_override_count(void) {
+    return 2;
+}
+
+const key_override_t *key_override_get(uint16_t key_override_idx) {
+    switch (key_override_idx) {
+        case 0:
+            return &delete_override;
+        case 1:
+            return &ctrl_a_override;
+        default:
+            return NULL;
+    }
+}
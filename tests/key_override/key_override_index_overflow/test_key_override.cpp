@@ -0,0 +1,41 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::InSequence;
+
+class KeyOverrideIndexOverflow : public TestFixture {};
+
+TEST_F(KeyOverrideIndexOverflow, overrides_activate_without_index) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_ctrl(0, 0, 0, KC_LEFT_CTRL);
+    KeymapKey  key_a(0, 1, 0, KC_A);
+    set_keymap({key_ctrl, key_a});
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    key_ctrl.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_ctrl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
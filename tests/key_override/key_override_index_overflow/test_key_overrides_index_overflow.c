@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+const key_override_t delete_override = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t ctrl_a_override = ko_make_basic(MOD_MASK_CTRL, KC_A, KC_B);
+
+// clang-format off
+const key_override_t *key_overrides[] = {
+    &delete_override,
+};
+// clang-format on
@@ -0,0 +1,180 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class KeyOverride : public TestFixture {};
+
+TEST_F(KeyOverride, trigger_pressed_while_mod_held) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_bspc(0, 1, 0, KC_BACKSPACE);
+    set_keymap({key_shift, key_bspc});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_DELETE));
+    key_bspc.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    key_bspc.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, first_matching_override_wins) {
+    TestDriver driver;
+    KeymapKey  key_ctrl(0, 0, 0, KC_LEFT_CTRL);
+    KeymapKey  key_shift(0, 1, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_a(0, 2, 0, KC_A);
+    set_keymap({key_ctrl, key_shift, key_a});
+
+    // Both ctrl_a_override and shift_a_override match, the one listed first activates
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_B, KC_LEFT_SHIFT));
+    key_ctrl.press();
+    run_one_scan_loop();
+    key_shift.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL, KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_ctrl.release();
+    run_one_scan_loop();
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Only shift_a_override matches
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_C));
+    key_shift.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, mod_pressed_while_trigger_held) {
+    TestDriver driver;
+    KeymapKey  key_alt(0, 0, 0, KC_LEFT_ALT);
+    KeymapKey  key_a(0, 1, 0, KC_A);
+    set_keymap({key_alt, key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Activated by the modifier, the replacement is registered after the key repeat delay
+    EXPECT_EMPTY_REPORT(driver);
+    key_alt.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_D));
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_ALT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_alt.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, negative_mod_blocks_override) {
+    TestDriver driver;
+    KeymapKey  key_alt(0, 0, 0, KC_LEFT_ALT);
+    KeymapKey  key_gui(0, 1, 0, KC_LEFT_GUI);
+    KeymapKey  key_a(0, 2, 0, KC_A);
+    set_keymap({key_alt, key_gui, key_a});
+
+    // GUI is a negative mod of alt_a_override, so A is sent unchanged
+    EXPECT_REPORT(driver, (KC_LEFT_GUI));
+    EXPECT_REPORT(driver, (KC_LEFT_GUI, KC_LEFT_ALT));
+    EXPECT_REPORT(driver, (KC_LEFT_GUI, KC_LEFT_ALT, KC_A));
+    key_gui.press();
+    run_one_scan_loop();
+    key_alt.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_GUI, KC_LEFT_ALT));
+    EXPECT_REPORT(driver, (KC_LEFT_GUI));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_alt.release();
+    run_one_scan_loop();
+    key_gui.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, override_without_trigger_key) {
+    TestDriver driver;
+    KeymapKey  key_ctrl(0, 0, 0, KC_RIGHT_CTRL);
+    KeymapKey  key_shift(0, 1, 0, KC_RIGHT_SHIFT);
+    set_keymap({key_ctrl, key_shift});
+
+    EXPECT_REPORT(driver, (KC_RIGHT_CTRL));
+    key_ctrl.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_E));
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_RIGHT_CTRL, KC_RIGHT_SHIFT));
+    EXPECT_REPORT(driver, (KC_RIGHT_CTRL));
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    key_ctrl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
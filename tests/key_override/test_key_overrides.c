@@ -0,0 +1,40 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+// Filler overrides that never match the keys used by the tests, so that lookups have to skip past them
+#define FILLER_OVERRIDE(n) const key_override_t filler_override_##n = ko_make_basic(MOD_MASK_CTRL, KC_F##n, KC_NO)
+
+FILLER_OVERRIDE(1);
+FILLER_OVERRIDE(2);
+FILLER_OVERRIDE(3);
+FILLER_OVERRIDE(4);
+FILLER_OVERRIDE(5);
+FILLER_OVERRIDE(6);
+FILLER_OVERRIDE(7);
+FILLER_OVERRIDE(8);
+
+const key_override_t delete_override  = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+const key_override_t ctrl_a_override  = ko_make_basic(MOD_MASK_CTRL, KC_A, KC_B);
+// Listed after ctrl_a_override with the same trigger, so it only wins when ctrl_a_override doesn't match
+const key_override_t shift_a_override = ko_make_basic(MOD_MASK_SHIFT, KC_A, KC_C);
+const key_override_t alt_a_override  = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_A, KC_D, ~0, MOD_MASK_GUI);
+const key_override_t rctl_rsft_override = ko_make_basic(MOD_BIT(KC_RIGHT_CTRL) | MOD_BIT(KC_RIGHT_SHIFT), KC_NO, KC_E);
+
+// clang-format off
+const key_override_t *key_overrides[] = {
+    &filler_override_1,
+    &filler_override_2,
+    &filler_override_3,
+    &filler_override_4,
+    &delete_override,
+    &ctrl_a_override,
+    &filler_override_5,
+    &filler_override_6,
+    &shift_a_override,
+    &alt_a_override,
+    &filler_override_7,
+    &filler_override_8,
+    &rctl_rsft_override,
+};
+// clang-format on
@@ -0,0 +1,196 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_util.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+static bool endpoint_busy = false;
+
+extern "C" bool keyboard_ready(void) {
+    return !endpoint_busy;
+}
+
+class ReportCoalescing : public TestFixture {};
+
+TEST_F(ReportCoalescing, chord_is_sent_as_one_report) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b});
+
+    /* Press both keys within one scan. */
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_a.press();
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release both keys within one scan. */
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, modified_keycode_is_sent_as_one_report) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, LSFT(KC_A));
+
+    set_keymap({key});
+
+    /* Press key, the modifier arrives together with the key. */
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release key. */
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, tap_within_one_iteration_is_not_merged) {
+    TestDriver driver;
+    InSequence s;
+
+    /* Register and unregister a key without a delay in between. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    register_code(KC_A);
+    unregister_code(KC_A);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, retap_within_one_iteration_is_not_merged) {
+    TestDriver driver;
+    InSequence s;
+
+    /* Hold a key. */
+    EXPECT_REPORT(driver, (KC_A));
+    register_code(KC_A);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release and press it again without a delay in between. */
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    unregister_code(KC_A);
+    register_code(KC_A);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release key. */
+    EXPECT_EMPTY_REPORT(driver);
+    unregister_code(KC_A);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, report_is_flushed_before_delay) {
+    TestDriver driver;
+    InSequence s;
+
+    /* The press has to reach the host before the delay starts. */
+    EXPECT_REPORT(driver, (KC_A));
+    tap_code_delay(KC_A, 10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, tap_code16_is_flushed_before_delay) {
+    TestDriver driver;
+    InSequence s;
+
+    /* The press has to reach the host before the delay starts. */
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    tap_code16_delay(LSFT(KC_A), 10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, reverted_change_is_held_for_as_long_as_it_was_staged) {
+    TestDriver driver;
+    InSequence s;
+    uint16_t   press_time = 0;
+
+    /* Register and unregister a key with a delay in between, but without flushing. */
+    EXPECT_REPORT(driver, (KC_A)).WillOnce([&press_time](report_keyboard_t&) { press_time = timer_read(); });
+    register_code(KC_A);
+    wait_ms(20);
+    unregister_code(KC_A);
+    VERIFY_AND_CLEAR(driver);
+
+    /* The release follows the press only after the delay. */
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_GE(timer_elapsed(press_time), 20);
+}
+
+TEST_F(ReportCoalescing, held_keys_are_released_on_shutdown) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The main loop does not run again after a reset. */
+    EXPECT_EMPTY_REPORT(driver);
+    soft_reset_keyboard();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ReportCoalescing, tap_held_back_by_busy_endpoint_does_not_block) {
+    TestDriver driver;
+    InSequence s;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    /* The host stops polling while the key is pressed and released. */
+    EXPECT_NO_REPORT(driver);
+    endpoint_busy = true;
+    key.press();
+    idle_for(500);
+    key.release();
+    uint16_t release_time = timer_read();
+    run_one_scan_loop();
+    EXPECT_LE(timer_elapsed(release_time), 1);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    /* Once it polls again, the press and the release are sent one per iteration. */
+    endpoint_busy = false;
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TAP_HOLD_TABLE \
+    { {SFT_T(KC_P), 100, QUICK_TAP_TERM, TAP_HOLD_PERMISSIVE_HOLD} }
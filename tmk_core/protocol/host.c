@@ -72,6 +72,22 @@ led_t host_keyboard_led_state(void) {
 }
 
 /* send report */
+/** \brief Checks whether the host can take a keyboard report without blocking
+ */
+bool host_keyboard_ready(void) {
+#ifdef BLUETOOTH_ENABLE
+    if (where_to_send() == OUTPUT_BLUETOOTH) {
+        return true;
+    }
+#endif
+
+    return keyboard_ready();
+}
+
+__attribute__((weak)) bool keyboard_ready(void) {
+    return true;
+}
+
 void host_keyboard_send(report_keyboard_t *report) {
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {